@@ -0,0 +1,181 @@
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "engine/dealAnalysis.hpp"
+#include "engine/difficulty.hpp"
+
+/**
+ * @brief Counts records by outcome before passing them on, and reports the
+ * solver threads of parallel searches.
+ */
+class CountingWriter : public DealRecordWriter {
+ public:
+  explicit CountingWriter(DealRecordWriter& writer) : writer_(writer) {}
+
+  void write(const DealRecord& record) override {
+    counts_[record.outcome]++;
+    if (record.workers.size() > 1) {
+      for (size_t i = 0; i < record.workers.size(); i++) {
+        const WorkerStats& stats = record.workers[i];
+        std::cerr << "seed " << record.seed << " thread " << i << ": "
+                  << stats.nodes << " nodes, " << stats.steals << " steals, "
+                  << static_cast<uint64_t>(stats.nodesPerSecond())
+                  << " nodes/s\n";
+      }
+    }
+    writer_.write(record);
+  }
+
+  /**
+   * @brief Get the number of records written with an outcome.
+   */
+  uint64_t getCount(Outcome outcome) const { return counts_[outcome]; }
+
+ private:
+  DealRecordWriter& writer_;  ///< The writer records are passed to.
+  uint64_t counts_[3] = {0};  ///< Records per outcome.
+};
+
+static void printUsage(const char* program) {
+  std::cerr
+      << "Usage: " << program << " --first SEED --last SEED [options]\n"
+      << "Solve the deals shuffled with seeds FIRST to LAST.\n\n"
+      << "  --draw N       cards drawn from the deck at a time, 1 or 3 "
+         "(default 1)\n"
+      << "  --time S       time budget per deal in seconds (default 10)\n"
+      << "  --nodes N      node budget per deal, 0 for none (default 0)\n"
+      << "  --threads N    deals solved at once, 0 for all cores (default 0,\n"
+      << "                 1 with --split)\n"
+      << "  --split N      threads searching each deal, 0 for all cores\n"
+      << "                 (default 1), per-thread statistics go to stderr\n"
+      << "  --format F     csv, binary or ratings (default csv)\n"
+      << "  --playouts N   random playouts per deal for ratings (default 32)\n"
+      << "  --output FILE  write to FILE instead of standard output\n"
+      << "  --cache FILE   reuse and extend the solver cache FILE\n";
+}
+
+/**
+ * @brief Batch deal analysis: solves a range of seeds and streams the results.
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return 0 on success, 1 on bad arguments or output errors.
+ */
+int main(int argc, char* argv[]) {
+  uint64_t firstSeed = 0;
+  uint64_t lastSeed = 0;
+  bool hasFirst = false;
+  bool hasLast = false;
+  int drawCount = 1;
+  int threads = -1;
+  int solverThreads = 1;
+  SolverLimits limits;
+  limits.maxSeconds = 10;
+  std::string format = "csv";
+  std::string output;
+  std::string cachePath;
+  int playouts = DifficultyRater::defaultPlayouts;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    if (std::strcmp(arg, "--help") == 0) {
+      printUsage(argv[0]);
+      return 0;
+    }
+    if (i + 1 >= argc) {
+      printUsage(argv[0]);
+      return 1;
+    }
+    const char* value = argv[++i];
+    if (std::strcmp(arg, "--first") == 0) {
+      firstSeed = std::strtoull(value, nullptr, 10);
+      hasFirst = true;
+    } else if (std::strcmp(arg, "--last") == 0) {
+      lastSeed = std::strtoull(value, nullptr, 10);
+      hasLast = true;
+    } else if (std::strcmp(arg, "--draw") == 0) {
+      drawCount = std::atoi(value);
+    } else if (std::strcmp(arg, "--time") == 0) {
+      limits.maxSeconds = std::atof(value);
+    } else if (std::strcmp(arg, "--nodes") == 0) {
+      limits.maxNodes = std::strtoull(value, nullptr, 10);
+    } else if (std::strcmp(arg, "--threads") == 0) {
+      threads = std::atoi(value);
+    } else if (std::strcmp(arg, "--split") == 0) {
+      solverThreads = std::atoi(value);
+    } else if (std::strcmp(arg, "--format") == 0) {
+      format = value;
+    } else if (std::strcmp(arg, "--output") == 0) {
+      output = value;
+    } else if (std::strcmp(arg, "--playouts") == 0) {
+      playouts = std::atoi(value);
+    } else if (std::strcmp(arg, "--cache") == 0) {
+      cachePath = value;
+    } else {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (!hasFirst || !hasLast || lastSeed < firstSeed ||
+      (drawCount != 1 && drawCount != 3) ||
+      (format != "csv" && format != "binary" && format != "ratings")) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  if (threads < 0) {
+    // Splitting each search already keeps the cores busy
+    threads = solverThreads == 1 ? 0 : 1;
+  }
+
+  std::ofstream file;
+  if (!output.empty()) {
+    file.open(output, format == "binary" ? std::ios::out | std::ios::binary
+                                         : std::ios::out);
+    if (!file) {
+      std::cerr << "Cannot open " << output << "\n";
+      return 1;
+    }
+  }
+  std::ostream& out = output.empty() ? std::cout : file;
+
+  SolverCache cache;
+  if (!cachePath.empty() && !cache.open(cachePath)) {
+    std::cerr << "Cannot open " << cachePath << "\n";
+    return 1;
+  }
+
+  if (format == "ratings") {
+    // Ratings are written in one go, for DifficultyRater::load
+    DifficultyRater rater(threads, limits, playouts, 64,
+                          cache.isOpen() ? &cache : nullptr);
+    for (uint64_t seed = firstSeed; seed <= lastSeed && seed >= firstSeed;
+         seed++) {
+      rater.rate(seed, drawCount);
+    }
+    rater.wait();
+    rater.save(out);
+    out.flush();
+    std::cerr << "rated " << rater.size() << "\n";
+    return out ? 0 : 1;
+  }
+
+  std::unique_ptr<DealRecordWriter> writer;
+  if (format == "binary") {
+    writer = std::make_unique<BinaryRecordWriter>(out, drawCount);
+  } else {
+    writer = std::make_unique<CsvRecordWriter>(out);
+  }
+  CountingWriter counter(*writer);
+  analyzeDeals(firstSeed, lastSeed, drawCount, limits, threads, counter,
+               cache.isOpen() ? &cache : nullptr, solverThreads);
+  out.flush();
+
+  std::cerr << "won " << counter.getCount(WINNABLE) << ", lost "
+            << counter.getCount(UNWINNABLE) << ", unknown "
+            << counter.getCount(UNDECIDED) << "\n";
+  return out ? 0 : 1;
+}
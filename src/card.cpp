@@ -2,6 +2,7 @@
 
 #include <QDebug>
 
+#include "cardImages.hpp"
 #include "deck.hpp"
 #include "klondikePile.hpp"
 #include "targetPile.hpp"
@@ -16,20 +17,12 @@ Card::Card(Suit s, Rank r, QGraphicsItem *parent)
       isGlowing_(false),
       flipProgress_(180),
       QGraphicsObject(parent) {
-  color_ = (s == Suit::SPADES || s == Suit::CLUBS) ? Color::BLACK : Color::RED;
+  color_ = suitColor(s);
 
   setScale(SCALING_FACTOR);
 
   setFlags(QGraphicsItem::ItemIsSelectable | QGraphicsItem::ItemIsMovable);
 
-  QString frontIMG_path = QString(":/cards/%1.png").arg(cardToQString());
-  QString backIMG_path = QString(":/cards/face_down.png");
-  if (!frontImage_.load(frontIMG_path)) {
-    qDebug() << "Failed to load front image:" << frontIMG_path;
-  }
-  if (!backImage_.load(backIMG_path)) {
-    qDebug() << "Failed to load back image:" << backIMG_path;
-  }
   // Glow effect
   glowEffect_ = new QGraphicsDropShadowEffect(this);
   glowEffect_->setBlurRadius(0);
@@ -211,9 +204,33 @@ void Card::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
   Q_UNUSED(option);
   Q_UNUSED(widget);
 
+  // The images are shared by all cards, see CardImages
   int flipProg = getFlipProgress();
-  pixmap_ = (this->isFaceUp() == (flipProg >= 90)) ? frontImage_ : backImage_;
-  painter->drawPixmap(0, 0, pixmap_);
+  bool showFront = this->isFaceUp() == (flipProg >= 90);
+  const int index = showFront ? getIndex() : CardImages::backIndex;
+  const QImage &atlas = CardImages::atlas();
+  const QRect source = CardImages::sourceRect(index);
+
+  // When the card is shown at the size the atlas was made for, drop the
+  // scale and blit its face 1:1 at a whole device pixel. Mid flip the
+  // painter scales it like any other image.
+  const QTransform world = painter->worldTransform();
+  const qreal dpr = CardImages::renditionDpr();
+  const QSizeF shown = world.mapRect(boundingRect()).size() * dpr;
+  if (world.type() <= QTransform::TxScale &&
+      qAbs(shown.width() - source.width()) < 1 &&
+      qAbs(shown.height() - source.height()) < 1) {
+    painter->save();
+    painter->setWorldTransform(QTransform());
+    // The atlas' own ratio is 1, so the logical size is given explicitly
+    const QPointF position(qRound(world.dx() * dpr) / dpr,
+                           qRound(world.dy() * dpr) / dpr);
+    painter->drawImage(QRectF(position, QSizeF(source.size()) / dpr), atlas,
+                       QRectF(source));
+    painter->restore();
+  } else {
+    painter->drawImage(boundingRect(), atlas, QRectF(source));
+  }
 }
 
 void Card::animateFlip() { flipAnimation_->start(); }
@@ -237,10 +254,19 @@ void Card::setFlipProgress(const qreal &progress) {
 }
 
 void Card::animateMove(const QPointF &startPos, const QPointF &endPos,
-                       const unsigned int ms) {
+                       const unsigned int ms, const unsigned int delay) {
   moveAnimation_->stop();
   isMoving_ = true;
 
+  if (delay > 0) {
+    // Hold the card where it was until its turn
+    setPos(startPos);
+    QTimer::singleShot(delay, this, [this, startPos, endPos, ms]() {
+      animateMove(startPos, endPos, ms);
+    });
+    return;
+  }
+
   // Pile animates the card
   // startPos is determined by prevScenePoss_ more or less
   moveAnimation_->setDuration(ms);
@@ -300,5 +326,5 @@ void Card::setParentZValue(const qreal &value) {
 }
 
 QRectF Card::boundingRect() const {
-  return QRectF(0, 0, pixmap_.width(), pixmap_.height());
+  return QRectF(QPointF(0, 0), CardImages::size());
 }
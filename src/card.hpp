@@ -8,52 +8,15 @@
 #include <QPropertyAnimation>
 #include <QTimer>
 
+#include "engine/cardState.hpp"
+#include "engine/cardTypes.hpp"
+#include "engine/moveTables.hpp"
+
 #define SCALING_FACTOR 0.2
 #define MAX_GLOW 110
 
 using namespace std;
 
-/**
- * @brief Enumeration for the four suits in a deck of cards.
- */
-enum Suit { CLUBS, DIAMONDS, SPADES, HEARTS };
-
-/**
- * @brief Enumeration for the ranks in a deck of cards, with ACE set to 1 and
- * KING as the highest rank.
- */
-enum Rank {
-  ACE = 1,
-  TWO,
-  THREE,
-  FOUR,
-  FIVE,
-  SIX,
-  SEVEN,
-  EIGHT,
-  NINE,
-  TEN,
-  JACK,
-  QUEEN,
-  KING
-};
-
-/**
- * @brief Enumeration for the color of a card, either BLACK or RED.
- */
-enum Color { BLACK, RED };
-
-/**
- * @brief Array of all possible suits, used to initialize a deck.
- */
-constexpr Suit allSuits[] = {CLUBS, DIAMONDS, SPADES, HEARTS};
-
-/**
- * @brief Array of all possible ranks, used to initialize a deck.
- */
-constexpr Rank allRanks[] = {ACE,   TWO,  THREE, FOUR, FIVE,  SIX, SEVEN,
-                             EIGHT, NINE, TEN,   JACK, QUEEN, KING};
-
 class Pile;
 
 /**
@@ -97,6 +60,12 @@ class Card : public QGraphicsObject {
    */
   Rank getRank() const { return rank_; }
 
+  /**
+   * @brief Get the index of the card, used to look up the move tables.
+   * @return suit * 13 + rank - 1, see cardIndex.
+   */
+  int getIndex() const { return cardIndex(suit_, rank_); }
+
   /**
    * @brief Get the Suit in QString
    * @return QString of the suit
@@ -115,6 +84,12 @@ class Card : public QGraphicsObject {
    */
   bool isFaceUp() const { return faceUp_; }
 
+  /**
+   * @brief Get the rules engine representation of the card.
+   * @return CardState with the same suit, rank and face-up status.
+   */
+  CardState getState() const { return CardState(suit_, rank_, faceUp_); }
+
   /**
    * @brief Get the color of the card.
    * @return Color of the card (BLACK or RED).
@@ -184,9 +159,13 @@ class Card : public QGraphicsObject {
 
   /**
    * @brief Start the moving animation.
+   * @param startPos Start position in the parent pile's coordinates.
+   * @param endPos End position in the parent pile's coordinates.
+   * @param ms Duration of the animation in milliseconds.
+   * @param delay Time the card waits at startPos first, in milliseconds.
    */
   void animateMove(const QPointF& startPos, const QPointF& endPos,
-                   const unsigned int ms = 500);
+                   const unsigned int ms = 500, const unsigned int delay = 0);
 
   /**
    * @brief Start the glowing animation.
@@ -330,10 +309,6 @@ class Card : public QGraphicsObject {
     glowEffect_->setBlurRadius(radius);
   }
 
-  QPixmap frontImage_;  ///< The front image of the card.
-  QPixmap backImage_;   ///< The back image of the card.
-  QPixmap pixmap_;      ///< Current pixmap (image).
-
   QGraphicsDropShadowEffect*
       glowEffect_;  ///< Drop shadow effect used for glowing the card.
   QPropertyAnimation* glowInAnimation_;   ///< Animation for glowing in.
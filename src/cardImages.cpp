@@ -0,0 +1,414 @@
+#include "cardImages.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QPainter>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "card.hpp"
+#include "cardAssets.hpp"
+
+static const char* const suitNames[] = {"clubs", "diamonds", "spades",
+                                        "hearts"};
+static const char* const rankNames[] = {"ace", "2", "3",  "4",    "5",
+                                        "6",   "7", "8",  "9",    "10",
+                                        "jack", "queen", "king"};
+
+static const char packMagic[4] = {'K', 'C', 'P', '2'};
+
+/**
+ * @brief Header of the card pack, see CardImages::writePack.
+ */
+struct PackHeader {
+  char magic[4];    ///< packMagic.
+  uint32_t count;   ///< Number of faces, CardImages::faceCount.
+  uint32_t width;   ///< Width of every face in pixels.
+  uint32_t height;  ///< Height of every face in pixels.
+};
+
+static const uint32_t packRun = 0x80000000u;  ///< Marks a run in the pack.
+static const int packMinRun = 4;  ///< Shorter runs are stored as literals.
+
+static const int atlasColumns = 13;  ///< One column per rank.
+static const int atlasRows = 5;      ///< One row per suit, one for the back.
+static const int atlasGap = 1;       ///< Empty pixels between the faces.
+
+static const char atlasMagic[4] = {'K', 'C', 'A', '1'};
+
+/**
+ * @brief Header of a cached atlas, followed by its premultiplied ARGB32
+ * scanlines.
+ */
+struct AtlasHeader {
+  char magic[4];      ///< atlasMagic.
+  uint32_t width;     ///< Width of the atlas in pixels.
+  uint32_t height;    ///< Height of the atlas in pixels.
+  uint32_t dprMilli;  ///< Device pixel ratio times 1000.
+};
+
+static QString cacheDir;        ///< Where atlases are cached, or empty.
+static QFile atlasFile;         ///< Cached atlas being mapped, if any.
+static QImage renditionAtlas;   ///< All faces at the rendition size.
+static int atlasVersion = 0;    ///< Version the atlas was built at.
+static int currentVersion = 0;  ///< Bumped whenever the scale changes.
+static QSize currentSize;       ///< Rendition size in device pixels.
+static qreal currentDpr = 1.0;  ///< Device pixel ratio of the renditions.
+
+QString CardImages::path(int index) {
+  if (index == backIndex) {
+    return QString(":/cards/face_down.png");
+  }
+  return QString(":/cards/%1_of_%2.png")
+      .arg(rankNames[indexRank(index) - 1])
+      .arg(suitNames[indexSuit(index)]);
+}
+
+/**
+ * @brief Decode a face from the PNG resources.
+ * @param index cardIndex of the front, or backIndex.
+ * @param image Set to the face, premultiplied and at CardImages::size().
+ * @return false if the resource failed to decode.
+ */
+static bool loadFace(int index, QImage& image) {
+  if (!image.load(CardImages::path(index))) {
+    qDebug() << "Failed to load card image:" << CardImages::path(index);
+    return false;
+  }
+  // The fronts are a few pixels smaller than the back
+  if (image.size() != CardImages::size()) {
+    image = image.scaled(CardImages::size(), Qt::IgnoreAspectRatio,
+                         Qt::SmoothTransformation);
+  }
+  image.convertTo(QImage::Format_ARGB32_Premultiplied);
+  return true;
+}
+
+/**
+ * @brief Run-length encode the pixels of a face, see CardImages::writePack.
+ * @param image Face to encode, premultiplied ARGB32.
+ * @param out Words to append to.
+ */
+static void packFace(const QImage& image, std::vector<uint32_t>& out) {
+  // The scanlines of a 32-bit image are contiguous
+  const uint32_t* pixels = reinterpret_cast<const uint32_t*>(image.constBits());
+  const size_t count = size_t(image.width()) * image.height();
+  size_t i = 0;
+  size_t literal = 0;
+  while (i < count) {
+    size_t run = 1;
+    while (i + run < count && pixels[i + run] == pixels[i]) {
+      run++;
+    }
+    if (run < size_t(packMinRun)) {
+      i += run;
+      continue;
+    }
+    if (literal < i) {
+      out.push_back(uint32_t(i - literal));
+      out.insert(out.end(), pixels + literal, pixels + i);
+    }
+    out.push_back(packRun | uint32_t(run));
+    out.push_back(pixels[i]);
+    i += run;
+    literal = i;
+  }
+  if (literal < count) {
+    out.push_back(uint32_t(count - literal));
+    out.insert(out.end(), pixels + literal, pixels + count);
+  }
+}
+
+/**
+ * @brief Decode one face of the card pack.
+ * @param in Next word of the pack, moved past the face.
+ * @param end End of the pack.
+ * @param image Preallocated face to fill.
+ * @return false if the words do not decode to exactly one face.
+ */
+static bool unpackFace(const uint32_t*& in, const uint32_t* end,
+                       QImage& image) {
+  uint32_t* out = reinterpret_cast<uint32_t*>(image.bits());
+  uint32_t* const outEnd = out + size_t(image.width()) * image.height();
+  while (out < outEnd) {
+    if (in == end) {
+      return false;
+    }
+    const uint32_t word = *in++;
+    const size_t length = word & ~packRun;
+    if (length == 0 || length > size_t(outEnd - out)) {
+      return false;
+    }
+    if (word & packRun) {
+      if (in == end) {
+        return false;
+      }
+      std::fill(out, out + length, *in++);
+    } else {
+      if (length > size_t(end - in)) {
+        return false;
+      }
+      memcpy(out, in, length * sizeof(uint32_t));
+      in += length;
+    }
+    out += length;
+  }
+  return true;
+}
+
+bool CardImages::readPack(const QString& fileName, QImage* images) {
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const qint64 fileSize = file.size();
+  const uchar* data = file.map(0, fileSize);
+  PackHeader header;
+  if (!data || fileSize < qint64(sizeof(header)) ||
+      fileSize % sizeof(uint32_t) != 0) {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, packMagic, sizeof(packMagic)) != 0 ||
+      header.count != faceCount || header.width != uint32_t(size().width()) ||
+      header.height != uint32_t(size().height())) {
+    qDebug() << "Ignoring invalid card pack:" << fileName;
+    return false;
+  }
+  const uint32_t* in = reinterpret_cast<const uint32_t*>(data + sizeof(header));
+  const uint32_t* end = reinterpret_cast<const uint32_t*>(data + fileSize);
+  for (int i = 0; i < faceCount; i++) {
+    images[i] = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+    if (!unpackFace(in, end, images[i])) {
+      qDebug() << "Ignoring invalid card pack:" << fileName;
+      return false;
+    }
+  }
+  return in == end;
+}
+
+const QImage* CardImages::faces() {
+  static QImage images[faceCount];
+  static bool loaded = false;
+  if (!loaded) {
+    loaded = true;
+    QElapsedTimer timer;
+    timer.start();
+    QString pack =
+        QDir(QCoreApplication::applicationDirPath()).filePath(packName);
+    if (readPack(pack, images)) {
+      qDebug() << "Card images unpacked from" << pack << "in"
+               << timer.elapsed() << "ms";
+      return images;
+    }
+    for (int i = 0; i < faceCount; i++) {
+      loadFace(i, images[i]);
+    }
+    qDebug() << "Card images decoded in" << timer.elapsed() << "ms";
+  }
+  return images;
+}
+
+bool CardImages::writePack(const QString& fileName) {
+  PackHeader header;
+  memcpy(header.magic, packMagic, sizeof(packMagic));
+  header.count = faceCount;
+  header.width = size().width();
+  header.height = size().height();
+
+  std::vector<uint32_t> words;
+  for (int i = 0; i < faceCount; i++) {
+    QImage image;
+    if (!loadFace(i, image)) {
+      return false;
+    }
+    packFace(image, words);
+  }
+
+  QSaveFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  const qint64 bytes = qint64(words.size()) * sizeof(uint32_t);
+  if (file.write(reinterpret_cast<const char*>(&header), sizeof(header)) !=
+          sizeof(header) ||
+      file.write(reinterpret_cast<const char*>(words.data()), bytes) !=
+          bytes) {
+    return false;
+  }
+  return file.commit();
+}
+
+const QImage& CardImages::face(int index) { return faces()[index]; }
+
+QSize CardImages::size() { return QSize(CARD_IMAGE_WIDTH, CARD_IMAGE_HEIGHT); }
+
+void CardImages::setRenditionScale(qreal scale, qreal dpr) {
+  QSize size = (QSizeF(CardImages::size()) * scale * dpr).toSize();
+  if (size == currentSize && dpr == currentDpr) {
+    return;
+  }
+  currentSize = size;
+  currentDpr = dpr;
+  currentVersion++;
+}
+
+QSize CardImages::renditionSize() {
+  if (currentSize.isEmpty()) {
+    setRenditionScale(SCALING_FACTOR, 1.0);
+  }
+  return currentSize;
+}
+
+qreal CardImages::renditionDpr() {
+  renditionSize();
+  return currentDpr;
+}
+
+QRect CardImages::sourceRect(int index) {
+  const QSize size = renditionSize();
+  const int column = index == backIndex ? 0 : index % atlasColumns;
+  const int row = index == backIndex ? atlasRows - 1 : index / atlasColumns;
+  return QRect(column * (size.width() + atlasGap),
+               row * (size.height() + atlasGap), size.width(), size.height());
+}
+
+/**
+ * @brief Get a hash of the card images, so cached atlases of other images
+ * are not used.
+ * @return Hex digest, computed at build time.
+ */
+static QString assetHash() { return QStringLiteral(CARD_IMAGES_HASH); }
+
+/**
+ * @brief Get the path the atlas for the current size is cached at.
+ * @return Path in cacheDir, e.g. "atlas-120x174-1000-0123456789abcdef.raw".
+ */
+static QString atlasPath() {
+  const QSize size = CardImages::renditionSize();
+  return QDir(cacheDir).filePath(QString("atlas-%1x%2-%3-%4.raw")
+                                     .arg(size.width())
+                                     .arg(size.height())
+                                     .arg(qRound(currentDpr * 1000))
+                                     .arg(assetHash()));
+}
+
+/**
+ * @brief Map a cached atlas into renditionAtlas.
+ * @param fileName Path of the cached atlas.
+ * @param width Expected width of the atlas in pixels.
+ * @param height Expected height of the atlas in pixels.
+ * @return false if the file is missing or does not match.
+ */
+static bool mapAtlas(const QString& fileName, int width, int height) {
+  // The current atlas may be mapped from the file being replaced
+  renditionAtlas = QImage();
+  atlasFile.close();
+  atlasFile.setFileName(fileName);
+  if (!atlasFile.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const qint64 fileSize = atlasFile.size();
+  const uchar* data = atlasFile.map(0, fileSize);
+  AtlasHeader header;
+  if (!data || fileSize < qint64(sizeof(header))) {
+    atlasFile.close();
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (memcmp(header.magic, atlasMagic, sizeof(atlasMagic)) != 0 ||
+      header.width != uint32_t(width) || header.height != uint32_t(height) ||
+      header.dprMilli != uint32_t(qRound(currentDpr * 1000)) ||
+      fileSize != qint64(sizeof(header)) + qint64(width) * height * 4) {
+    atlasFile.close();
+    return false;
+  }
+  // Read-only, so nothing may detach it, e.g. setDevicePixelRatio would
+  // copy the whole atlas to the heap
+  renditionAtlas = QImage(data + sizeof(header), width, height, width * 4,
+                          QImage::Format_ARGB32_Premultiplied);
+  return true;
+}
+
+const QImage& CardImages::atlas() {
+  const QSize size = renditionSize();
+  if (atlasVersion == currentVersion && !renditionAtlas.isNull()) {
+    return renditionAtlas;
+  }
+  atlasVersion = currentVersion;
+  const int width = (size.width() + atlasGap) * atlasColumns;
+  const int height = (size.height() + atlasGap) * atlasRows;
+  if (!cacheDir.isEmpty() && mapAtlas(atlasPath(), width, height)) {
+    return renditionAtlas;
+  }
+  QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
+  image.fill(Qt::transparent);
+  QPainter painter(&image);
+  for (int i = 0; i < faceCount; i++) {
+    painter.drawImage(sourceRect(i).topLeft(),
+                      face(i).scaled(size, Qt::IgnoreAspectRatio,
+                                     Qt::SmoothTransformation));
+  }
+  painter.end();
+  renditionAtlas = std::move(image);
+  atlasFile.close();
+  return renditionAtlas;
+}
+
+void CardImages::setCacheDir(const QString& dir) { cacheDir = dir; }
+
+bool CardImages::saveCache() {
+  if (cacheDir.isEmpty() || !QDir().mkpath(cacheDir)) {
+    return false;
+  }
+  const QImage& image = atlas();
+  const QString fileName = atlasPath();
+  QFile existing(fileName);
+  if (existing.exists()) {
+    // Mark it as the most recently used one
+    if (existing.open(QIODevice::ReadWrite)) {
+      existing.setFileTime(QDateTime::currentDateTime(),
+                           QFileDevice::FileModificationTime);
+    }
+  } else {
+    AtlasHeader header;
+    memcpy(header.magic, atlasMagic, sizeof(atlasMagic));
+    header.width = image.width();
+    header.height = image.height();
+    header.dprMilli = qRound(currentDpr * 1000);
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+      return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const qint64 lineBytes = qint64(image.width()) * 4;
+    for (int y = 0; y < image.height(); y++) {
+      file.write(reinterpret_cast<const char*>(image.constScanLine(y)),
+                 lineBytes);
+    }
+    if (!file.commit()) {
+      return false;
+    }
+  }
+
+  // Newest first, keep the recent atlases of these card images
+  const QFileInfoList cached = QDir(cacheDir).entryInfoList(
+      {"atlas-*.raw"}, QDir::Files, QDir::Time);
+  int kept = 0;
+  for (const QFileInfo& info : cached) {
+    bool current = info.completeBaseName().endsWith(assetHash());
+    if (current && kept < maxCachedAtlases) {
+      kept++;
+    } else {
+      QFile::remove(info.filePath());
+    }
+  }
+  return true;
+}
@@ -0,0 +1,185 @@
+#ifndef CARD_IMAGES_HPP
+#define CARD_IMAGES_HPP
+
+#include <QImage>
+#include <QSize>
+#include <QString>
+
+#include "engine/cardTypes.hpp"
+
+/**
+ * @class CardImages
+ * @brief Process-wide store of the decoded card face images.
+ *
+ * Each of the 52 fronts and the shared back is loaded once, on first use, and
+ * then shared by every Card of every game. Cards only keep their index into
+ * the store, so dealing a new game does not touch the images at all. Must
+ * only be used from the GUI thread.
+ *
+ * The faces are normally read from a card pack next to the executable, a
+ * file written at build time by solitaire_cardpack that holds them already
+ * decoded as QImage::Format_ARGB32_Premultiplied and run-length encoded, so
+ * startup inflates no PNGs. Without a valid pack the PNG resources are
+ * decoded instead. Fronts whose image differs in size from the back are
+ * scaled to it either way.
+ *
+ * Cards are painted from renditions, copies of the faces scaled once to the
+ * exact device-pixel size they are shown at. All 53 renditions live in a
+ * single atlas image, so painting the table draws sub-rects of one image
+ * instead of switching between 53. The layout reports the size with
+ * setRenditionScale and the atlas is rebuilt the next time it is painted, so
+ * a repaint is a plain blit instead of a resample of the full-size image.
+ *
+ * With a cache directory set, the atlas in use is saved there by saveCache,
+ * keyed by its size, device pixel ratio and a hash of the card images. A
+ * later launch showing the cards at the same size maps that file instead of
+ * scaling the 53 faces again, and never loads the faces at all. The hash
+ * and the image size are computed at build time, see cardAssets.hpp.in.
+ */
+class CardImages {
+ public:
+  /// Number of faces in the store, the 52 fronts and the back.
+  static constexpr int faceCount = 53;
+
+  /// Index of the face-down image, the fronts use cardIndex.
+  static constexpr int backIndex = 52;
+
+  /// File name of the card pack, looked up in the executable's directory.
+  static constexpr const char* packName = "cards.pack";
+
+  /// Number of atlases kept in the cache directory, the most recent ones.
+  static constexpr int maxCachedAtlases = 4;
+
+  /**
+   * @brief Get a face image, loading the whole set on first use.
+   * @param index cardIndex of the front, or backIndex.
+   * @return The shared image, null if it failed to load.
+   */
+  static const QImage& face(int index);
+
+  /**
+   * @brief Get the front image of a card.
+   * @param s Suit of the card.
+   * @param r Rank of the card.
+   * @return The shared image.
+   */
+  static const QImage& front(Suit s, Rank r) {
+    return face(cardIndex(s, r));
+  }
+
+  /**
+   * @brief Get the face-down image shared by all cards.
+   * @return The shared image.
+   */
+  static const QImage& back() { return face(backIndex); }
+
+  /**
+   * @brief Get the size of the card images in pixels.
+   *
+   * Known at build time, so this does not load the images.
+   * @return Size of the back image, all faces have the same size.
+   */
+  static QSize size();
+
+  /**
+   * @brief Get the resource path of a face image.
+   * @param index cardIndex of the front, or backIndex.
+   * @return Path like ":/cards/ace_of_spades.png".
+   */
+  static QString path(int index);
+
+  /**
+   * @brief Decode the PNG resources and write them as a card pack.
+   *
+   * The pack is a 16 byte header, "KCP2" and the face count, width and
+   * height as native 32-bit integers, followed by the faces in index order as
+   * premultiplied ARGB32 pixels. Each face is a sequence of native 32-bit
+   * words: a length with the top bit set is a run of the pixel in the next
+   * word, otherwise it is followed by that many literal pixels. The runs
+   * shrink the raw faces about sevenfold and cost little more than a copy to
+   * expand. It is a build artifact for the machine it was made on, not a
+   * portable format.
+   * @param fileName File to write.
+   * @return true on success, false if a face failed to decode or the write
+   * failed.
+   */
+  static bool writePack(const QString& fileName);
+
+  /**
+   * @brief Read the faces from a card pack, see writePack.
+   * @param fileName Path of the pack.
+   * @param images Array of faceCount images to fill.
+   * @return false if the pack is missing or does not match the current
+   * format and images.
+   */
+  static bool readPack(const QString& fileName, QImage* images);
+
+  /**
+   * @brief Set the size the cards are shown at.
+   *
+   * Does nothing when the size does not change, otherwise the renditions are
+   * marked stale and regenerated lazily by rendition.
+   * @param scale Total scale of a card, its own scale times the pile scale.
+   * @param dpr Device pixel ratio of the view the cards are shown in.
+   */
+  static void setRenditionScale(qreal scale, qreal dpr);
+
+  /**
+   * @brief Get the atlas holding every face at the current rendition scale.
+   *
+   * The faces sit in a grid, one row per suit with the back starting the
+   * last row, see sourceRect. The image's own device pixel ratio is left at
+   * 1, as setting it would copy a mapped atlas; painters use renditionDpr.
+   * Until a scale is set the card's own SCALING_FACTOR is used. The atlas is
+   * mapped from the cache directory when it has one of the right size.
+   * @return The shared atlas.
+   */
+  static const QImage& atlas();
+
+  /**
+   * @brief Get where a face is in the atlas.
+   * @param index cardIndex of the front, or backIndex.
+   * @return Rectangle in the atlas, in device pixels.
+   */
+  static QRect sourceRect(int index);
+
+  /**
+   * @brief Get the size of the renditions in device pixels.
+   * @return Size of one face in the atlas.
+   */
+  static QSize renditionSize();
+
+  /**
+   * @brief Get the device pixel ratio the renditions were made for.
+   * @return Ratio of device pixels in the atlas to logical pixels.
+   */
+  static qreal renditionDpr();
+
+  /**
+   * @brief Set the directory atlases are cached in across launches.
+   * @param dir Directory, created on the first save. Empty disables the
+   * cache, which is the default.
+   */
+  static void setCacheDir(const QString& dir);
+
+  /**
+   * @brief Save the atlas in use to the cache directory.
+   *
+   * Meant to be called once the size has settled, e.g. on exit, so the sizes
+   * passed through while the window is resized are not written. Atlases of
+   * other card images and all but the maxCachedAtlases most recently used
+   * ones are removed.
+   * @return true if the atlas is in the cache, false if there is no cache
+   * directory or the write failed.
+   */
+  static bool saveCache();
+
+ private:
+  /**
+   * @brief Get the store, loading all faces the first time.
+   * @return Array of faceCount images.
+   */
+  static const QImage* faces();
+};
+
+#endif  // CARD_IMAGES_HPP
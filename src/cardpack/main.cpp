@@ -0,0 +1,22 @@
+#include <iostream>
+
+#include "cardImages.hpp"
+
+/**
+ * @brief Build step: decodes the card images into the pack the game reads.
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return 0 on success, 1 on bad arguments or errors.
+ */
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " OUTPUT\n"
+              << "Write the card images, decoded, to the card pack OUTPUT.\n";
+    return 1;
+  }
+  if (!CardImages::writePack(argv[1])) {
+    std::cerr << "Failed to write the card pack " << argv[1] << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -1,14 +1,14 @@
 #include "deck.hpp"
 
 #include <QDebug>
-#include <algorithm>
-#include <chrono>
-#include <random>
 #include <vector>
 
+#include "engine/deal.hpp"
 #include "wastePile.hpp"
 
-Deck::Deck(QGraphicsItem* parent) : Pile(parent) {
+Deck::Deck(QGraphicsItem* parent) : Deck(randomDealNumber(), parent) {}
+
+Deck::Deck(uint64_t dealNumber, QGraphicsItem* parent) : Pile(parent) {
   // Add cards to deck
   std::vector<Card*> aux;
   for (Suit suit : allSuits) {
@@ -17,20 +17,29 @@ Deck::Deck(QGraphicsItem* parent) : Pile(parent) {
     }
   }
 
-  Deck::shuffle<Card*>(aux);
+  Deck::shuffle<Card*>(aux, dealNumber);
   for (auto& card : aux) this->addCard(card);
 }
 
+Deck::Deck(const DealId& dealId, QGraphicsItem* parent) : Pile(parent) {
+  for (const CardState& state : unrankDeal(dealId)) {
+    this->addCard(new Card(state.getSuit(), state.getRank(), this));
+  }
+}
+
 // LOGIC RELATED FUNCTIONS
 
-template <typename T>
-void Deck::shuffle(std::vector<T>& arr, unsigned long seed) {
-  if (seed == 0) {
-    // Default seed is based on system time.
-    seed = chrono::high_resolution_clock::now().time_since_epoch().count();
+DealId Deck::getDealId() const {
+  std::vector<CardState> states;
+  for (const Card* card : cards_) {
+    states.push_back(card->getState());
   }
-  mt19937 generator(seed);
-  std::shuffle(arr.begin(), arr.end(), generator);
+  return rankDeal(states);
+}
+
+template <typename T>
+void Deck::shuffle(std::vector<T>& arr, uint64_t dealNumber) {
+  shuffleCards(arr, dealNumber);
 }
 
 bool Deck::isValid(const Card& card) { return false; }
@@ -38,10 +47,7 @@ bool Deck::isValid(const Card& card) { return false; }
 bool Deck::recycle(WastePile& pile) {
   if (this->isEmpty() && !pile.isEmpty()) {
     while (!pile.isEmpty()) {
-      Card* topCard = pile.getTopCard();
-      if (topCard->isFaceUp()) {
-        topCard->flip();
-      }
+      pile.flipTopCard(false);
       pile.transferCards(*this);
     }
     return true;
@@ -51,10 +57,7 @@ bool Deck::recycle(WastePile& pile) {
 
 void Deck::undoRecycle(WastePile& pile) {
   while (!this->isEmpty()) {
-    Card* topCard = this->getTopCard();
-    if (!topCard->isFaceUp()) {
-      topCard->flip();
-    }
+    flipTopCard(true);
     transferCards(pile);
   }
 }
@@ -1,6 +1,7 @@
 #ifndef DECK_HPP
 #define DECK_HPP
 
+#include "engine/dealId.hpp"
 #include "pile.hpp"
 
 using namespace std;
@@ -23,10 +24,33 @@ class Deck : public Pile {
 
   /**
    * @brief Construct a standard deck of 52 cards, each unique by suit and
-   * rank.
+   * rank, shuffled with a random deal number.
    */
   explicit Deck(QGraphicsItem* parent = nullptr);
 
+  /**
+   * @brief Construct a standard deck of 52 cards shuffled by a deal number.
+   * @param dealNumber The deal, the same number always gives the same order.
+   * @param parent Pointer to the parent QGraphicsItem, if any.
+   */
+  explicit Deck(uint64_t dealNumber, QGraphicsItem* parent = nullptr);
+
+  /**
+   * @brief Construct a standard deck of 52 cards in the order of an id.
+   * @param dealId A valid id, see rankDeal.
+   * @param parent Pointer to the parent QGraphicsItem, if any.
+   */
+  explicit Deck(const DealId& dealId, QGraphicsItem* parent = nullptr);
+
+  /**
+   * @brief Get the id of the order of the cards, see rankDeal.
+   *
+   * The deck must hold all 52 cards, as it does before dealing.
+   *
+   * @return The id, which gives back the same deck with Deck(const DealId&).
+   */
+  DealId getDealId() const;
+
   /**
    * @brief Add all cards from waste pile to the deck.
    * @param pile Waste pile that the cards are gathered from.
@@ -41,12 +65,12 @@ class Deck : public Pile {
   void undoRecycle(WastePile& pile);
 
   /**
-   * @brief Shuffle the deck using a random seed.
-   * @param seed Optional seed for reproducible shuffling. If 0 (default), the
-   * seed is based on system time.
+   * @brief Shuffle cards by a deal number, see shuffleCards.
+   * @param arr The cards to shuffle in place.
+   * @param dealNumber The deal, giving the same order on every platform.
    */
   template <typename T>
-  static void shuffle(vector<T>& arr, unsigned long seed = 0);
+  static void shuffle(vector<T>& arr, uint64_t dealNumber);
 
   /**
    * @brief Check if card can be legally added to deck. Override Pile::isValid.
@@ -0,0 +1,35 @@
+#include "engine/board.hpp"
+
+Board::Board() {
+  piles[deckIndex] = PileState(DECK_PILE, deckIndex);
+  piles[wasteIndex] = PileState(WASTE_PILE, wasteIndex);
+  for (int i = firstKlondikeIndex; i < firstTargetIndex; i++) {
+    piles[i] = PileState(KLONDIKE_PILE, i);
+  }
+  for (int i = firstTargetIndex; i < pileAm; i++) {
+    piles[i] = PileState(TARGET_PILE, i);
+  }
+}
+
+uint64_t Board::hash() const {
+  uint64_t hash = 0;
+  for (int i = 0; i < pileAm; i++) {
+    hash ^= placeHash(i, piles[i].getHash());
+  }
+  return hash;
+}
+
+uint64_t Board::canonicalHash() const {
+  // A sum does not depend on the order of the columns. Mixing each column
+  // first keeps cards from trading places between columns unnoticed.
+  uint64_t columns = 0;
+  for (int i = firstKlondikeIndex; i < firstTargetIndex; i++) {
+    columns += splitMix64(piles[i].getHash());
+  }
+  uint64_t hash = placeHash(deckIndex, piles[deckIndex].getHash()) ^
+                  placeHash(wasteIndex, piles[wasteIndex].getHash()) ^ columns;
+  for (int i = firstTargetIndex; i < pileAm; i++) {
+    hash ^= piles[i].getHash();
+  }
+  return hash;
+}
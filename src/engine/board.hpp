@@ -0,0 +1,133 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "engine/pileState.hpp"
+#include "engine/random.hpp"
+#include "engine/rules.hpp"
+
+/**
+ * @struct Board
+ * @brief Compact Klondike position: the thirteen piles on the table.
+ *
+ * Piles are referred to by index: the deck, the waste pile, the seven Klondike
+ * piles and the four target piles, in that order. The whole position is a few
+ * hundred bytes with no pointers, so it is copied with a single memcpy and
+ * solvers can clone positions cheaply.
+ */
+struct Board {
+  static constexpr int deckIndex = 0;   ///< Index of the deck.
+  static constexpr int wasteIndex = 1;  ///< Index of the waste pile.
+  static constexpr int firstKlondikeIndex = 2;  ///< Index of Klondike pile 0.
+  static constexpr int firstTargetIndex =
+      firstKlondikeIndex + KLONDIKE_PILE_AM;  ///< Index of target pile 0.
+  static constexpr int pileAm =
+      firstTargetIndex + TARGET_PILE_AM;  ///< Total number of piles.
+
+  std::array<PileState, pileAm> piles;  ///< All piles on the table.
+
+  /**
+   * @brief Construct an empty table with piles of the right kind.
+   */
+  Board();
+
+  /**
+   * @brief Get the Zobrist hash of the position.
+   *
+   * Each pile keeps the hash of its own cards up to date, so this only
+   * combines thirteen values.
+   *
+   * @return XOR of the hashes of all piles, each placed with placeHash.
+   */
+  uint64_t hash() const;
+
+  /**
+   * @brief Get a hash that is equal for positions equal up to the order of
+   * the Klondike piles and of the target piles.
+   *
+   * Such positions play the same, so a search only needs to visit one of
+   * them. The hash stands for the canonical form of the position, with its
+   * columns and target piles sorted, without building it: the mixed column
+   * hashes are added up, which does not depend on their order, and the
+   * target piles are combined with XOR, which cannot mix up their cards
+   * since the depth of a card on a target pile follows from its rank.
+   * Moves found from one position do not apply to the others, so the hash
+   * is for telling positions apart, not for keying moves.
+   *
+   * @return The canonical hash.
+   */
+  uint64_t canonicalHash() const;
+
+  /**
+   * @brief Tie the hash of a pile to its place on the table.
+   *
+   * Piles of one kind key their cards alike, see PileState::getHash, so the
+   * hash of each pile is multiplied by an odd number that depends on its
+   * index. An empty pile stays 0.
+   *
+   * @param index Index of the pile.
+   * @param pileHash Hash of the cards of the pile.
+   * @return The placed hash.
+   */
+  static constexpr uint64_t placeHash(int index, uint64_t pileHash) {
+    return pileHash * (splitMix64(index) | 1);
+  }
+
+  /**
+   * @brief Get the kind of the pile at an index.
+   */
+  static constexpr PileKind pileKind(int index) {
+    return index == deckIndex    ? DECK_PILE
+           : index == wasteIndex ? WASTE_PILE
+           : isKlondike(index)   ? KLONDIKE_PILE
+                                 : TARGET_PILE;
+  }
+
+  /**
+   * @brief Check whether a pile index refers to a Klondike pile.
+   */
+  static constexpr bool isKlondike(int index) {
+    return index >= firstKlondikeIndex && index < firstTargetIndex;
+  }
+
+  /**
+   * @brief Check whether a pile index refers to a target pile.
+   */
+  static constexpr bool isTarget(int index) {
+    return index >= firstTargetIndex && index < pileAm;
+  }
+
+  /**
+   * @brief Determines the type of move between two piles.
+   * @param fromPile Index of the originating pile.
+   * @param toPile Index of the destination pile.
+   * @return The determined MoveType.
+   */
+  static constexpr MoveType moveType(int fromPile, int toPile) {
+    if (fromPile == wasteIndex && isKlondike(toPile)) {
+      return WASTE_TO_KLONDIKE;
+    } else if (fromPile == wasteIndex && isTarget(toPile)) {
+      return WASTE_TO_TARGET;
+    } else if (isKlondike(fromPile) && isTarget(toPile)) {
+      return KLONDIKE_TO_TARGET;
+    } else if (isKlondike(fromPile) && isKlondike(toPile)) {
+      return KLONDIKE_TO_KLONDIKE;
+    } else if (isTarget(fromPile) && isKlondike(toPile)) {
+      return TARGET_TO_KLONDIKE;
+    } else if (fromPile == deckIndex && toPile == wasteIndex) {
+      return DECK_TO_WASTE;
+    } else if (fromPile == wasteIndex && toPile == deckIndex) {
+      return RECYCLE_DECK;
+    }
+    return UNKNOWN;
+  }
+};
+
+static_assert(std::is_trivially_copyable<Board>::value,
+              "Board must be copyable with memcpy");
+static_assert(sizeof(Board) <= 1024, "Board must stay compact");
+
+#endif  // BOARD_HPP
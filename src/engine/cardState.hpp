@@ -0,0 +1,88 @@
+#ifndef CARD_STATE_HPP
+#define CARD_STATE_HPP
+
+#include <cstdint>
+
+#include "engine/cardTypes.hpp"
+
+#define DECK_SIZE 52  ///< Number of cards in a deck.
+
+/**
+ * @class CardState
+ * @brief Plain value representation of a card packed into one byte.
+ *
+ * This is the Qt-free counterpart of Card used by the rules engine. Bits 0-5
+ * hold the card index (suit * 13 + rank - 1) and bit 6 the face-up status.
+ */
+class CardState {
+ public:
+  /**
+   * @brief Construct a card with specified suit and rank.
+   * @param s Suit of the card (CLUBS, DIAMONDS, SPADES, HEARTS).
+   * @param r Rank of the card (ACE to KING).
+   * @param faceUp Initial face-up status (default face-down).
+   */
+  constexpr CardState(Suit s = CLUBS, Rank r = ACE, bool faceUp = false)
+      : bits_(static_cast<uint8_t>(cardIndex(s, r) |
+                                   (faceUp ? faceUpBit : 0))) {}
+
+  /**
+   * @brief Construct a card from its index.
+   * @param index Card index between 0 and DECK_SIZE - 1, see getIndex.
+   * @param faceUp Initial face-up status (default face-down).
+   */
+  static constexpr CardState fromIndex(int index, bool faceUp = false) {
+    return CardState(indexSuit(index), indexRank(index), faceUp);
+  }
+
+  /**
+   * @brief Get the index of the card, see cardIndex.
+   */
+  constexpr int getIndex() const { return bits_ & indexMask; }
+
+  /**
+   * @brief Get the suit of the card.
+   * @return Suit of the card.
+   */
+  constexpr Suit getSuit() const { return indexSuit(getIndex()); }
+
+  /**
+   * @brief Get the rank of the card.
+   * @return Rank of the card.
+   */
+  constexpr Rank getRank() const { return indexRank(getIndex()); }
+
+  /**
+   * @brief Get the color of the card.
+   * @return Color of the card (BLACK or RED).
+   */
+  constexpr Color getColor() const { return suitColor(getSuit()); }
+
+  /**
+   * @brief Checks if the card is face-up.
+   * @return true if the card is face-up, false otherwise.
+   */
+  constexpr bool isFaceUp() const { return bits_ & faceUpBit; }
+
+  /**
+   * @brief Flip the card up/down.
+   */
+  void flip() { bits_ ^= faceUpBit; }
+
+  /**
+   * @brief Compare suit and rank, ignoring the face-up status.
+   */
+  constexpr bool sameCard(const CardState& other) const {
+    return getIndex() == other.getIndex();
+  }
+
+ private:
+  static constexpr uint8_t indexMask = 0x3F;  ///< Bits of the card index.
+  static constexpr uint8_t faceUpBit = 0x40;  ///< Bit of the face-up status.
+
+  uint8_t bits_;  ///< Card index and face-up status.
+};
+
+static_assert(sizeof(CardState) == 1, "CardState must fit in one byte");
+
+#endif  // CARD_STATE_HPP
@@ -0,0 +1,74 @@
+#ifndef CARD_TYPES_HPP
+#define CARD_TYPES_HPP
+
+/**
+ * @brief Enumeration for the four suits in a deck of cards.
+ */
+enum Suit { CLUBS, DIAMONDS, SPADES, HEARTS };
+
+/**
+ * @brief Enumeration for the ranks in a deck of cards, with ACE set to 1 and
+ * KING as the highest rank.
+ */
+enum Rank {
+  ACE = 1,
+  TWO,
+  THREE,
+  FOUR,
+  FIVE,
+  SIX,
+  SEVEN,
+  EIGHT,
+  NINE,
+  TEN,
+  JACK,
+  QUEEN,
+  KING
+};
+
+/**
+ * @brief Enumeration for the color of a card, either BLACK or RED.
+ */
+enum Color { BLACK, RED };
+
+/**
+ * @brief Array of all possible suits, used to initialize a deck.
+ */
+constexpr Suit allSuits[] = {CLUBS, DIAMONDS, SPADES, HEARTS};
+
+/**
+ * @brief Array of all possible ranks, used to initialize a deck.
+ */
+constexpr Rank allRanks[] = {ACE,   TWO,  THREE, FOUR, FIVE,  SIX, SEVEN,
+                             EIGHT, NINE, TEN,   JACK, QUEEN, KING};
+
+/**
+ * @brief Get the color of a suit.
+ * @param s Suit of the card.
+ * @return BLACK for clubs and spades, RED for diamonds and hearts.
+ */
+constexpr Color suitColor(Suit s) {
+  return (s == SPADES || s == CLUBS) ? BLACK : RED;
+}
+
+/**
+ * @brief Get the index of a card in a sorted deck.
+ * @param s Suit of the card.
+ * @param r Rank of the card.
+ * @return suit * 13 + rank - 1, between 0 and 51.
+ */
+constexpr int cardIndex(Suit s, Rank r) { return s * 13 + r - 1; }
+
+/**
+ * @brief Get the suit of a card from its index, see cardIndex.
+ */
+constexpr Suit indexSuit(int index) { return static_cast<Suit>(index / 13); }
+
+/**
+ * @brief Get the rank of a card from its index, see cardIndex.
+ */
+constexpr Rank indexRank(int index) {
+  return static_cast<Rank>(index % 13 + 1);
+}
+
+#endif  // CARD_TYPES_HPP
@@ -0,0 +1,59 @@
+#ifndef DEAL_HPP
+#define DEAL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "engine/cardState.hpp"
+#include "engine/random.hpp"
+
+/**
+ * @brief Shuffle a vector by a deal number.
+ *
+ * Shared by Deck::shuffle and the rules engine so that both deal the same
+ * cards for the same number. The shuffle only uses DealRandom and integer
+ * arithmetic, so a deal number gives the same deal on every platform.
+ *
+ * @param arr The vector to shuffle in place.
+ * @param dealNumber Any 64-bit number, each gives a fixed order.
+ */
+template <typename T>
+void shuffleCards(std::vector<T>& arr, uint64_t dealNumber) {
+  DealRandom random(dealNumber);
+  for (size_t i = arr.size(); i > 1; i--) {
+    std::swap(arr[i - 1], arr[random.below(i)]);
+  }
+}
+
+/**
+ * @brief Pick a deal number for a new game.
+ * @return A number from the system's random device mixed with the time.
+ */
+inline uint64_t randomDealNumber() {
+  std::random_device device;
+  const uint64_t bits = (static_cast<uint64_t>(device()) << 32) ^ device();
+  const uint64_t time =
+      std::chrono::high_resolution_clock::now().time_since_epoch().count();
+  return splitMix64(bits ^ time);
+}
+
+/**
+ * @brief Build a shuffled 52 card deck in the same order as Deck::Deck.
+ * @param dealNumber Deal number passed to shuffleCards.
+ * @return Face-down cards, the last element being the top of the deck.
+ */
+inline std::vector<CardState> shuffledDeck(uint64_t dealNumber) {
+  std::vector<CardState> cards;
+  for (Suit suit : allSuits) {
+    for (Rank rank : allRanks) {
+      cards.emplace_back(suit, rank);
+    }
+  }
+  shuffleCards(cards, dealNumber);
+  return cards;
+}
+
+#endif  // DEAL_HPP
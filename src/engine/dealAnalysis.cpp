@@ -0,0 +1,151 @@
+#include "engine/dealAnalysis.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "engine/deal.hpp"
+#include "engine/dealId.hpp"
+#include "engine/gameState.hpp"
+#include "engine/parallelSolver.hpp"
+
+static const char binaryMagic[4] = {'K', 'S', 'A', '1'};
+
+static void putLittleEndian(char* bytes, uint64_t value, int size) {
+  for (int i = 0; i < size; i++) {
+    bytes[i] = static_cast<char>(value >> (8 * i));
+  }
+}
+
+static uint64_t getLittleEndian(const char* bytes, int size) {
+  uint64_t value = 0;
+  for (int i = 0; i < size; i++) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i]))
+             << (8 * i);
+  }
+  return value;
+}
+
+DealRecord analyzeDeal(uint64_t seed, int drawCount,
+                       const SolverLimits& limits, SolverCache* cache,
+                       int solverThreads) {
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<CardState> deck = shuffledDeck(seed);
+  DealRecord record;
+  record.seed = seed;
+
+  DealId id;
+  if (cache != nullptr) {
+    id = rankDeal(deck);
+    CachedSolve cached;
+    if (cache->find(id, drawCount, cached)) {
+      record.outcome = cached.outcome;
+      record.solutionLength = cached.solution.size();
+      record.nodes = cached.nodes;
+      return record;
+    }
+  }
+
+  GameState state(deck, drawCount == 3);
+  SolveResult result = solverThreads == 1
+                           ? Solver(state).solve(limits)
+                           : ParallelSolver(state, solverThreads).solve(limits);
+  if (cache != nullptr) {
+    cache->insert(id, drawCount, result);
+  }
+
+  record.outcome = result.outcome;
+  record.solutionLength = result.solution.size();
+  record.nodes = result.nodes;
+  record.workers = std::move(result.workers);
+  record.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  return record;
+}
+
+CsvRecordWriter::CsvRecordWriter(std::ostream& out) : out_(out) {
+  out_ << "seed,result,solution_length,nodes,seconds\n";
+}
+
+void CsvRecordWriter::write(const DealRecord& record) {
+  static const char* const names[] = {"win", "loss", "unknown"};
+  out_ << record.seed << ',' << names[record.outcome] << ','
+       << record.solutionLength << ',' << record.nodes << ','
+       << record.seconds << '\n';
+}
+
+BinaryRecordWriter::BinaryRecordWriter(std::ostream& out, int drawCount)
+    : out_(out) {
+  out_.write(binaryMagic, sizeof(binaryMagic));
+  out_.put(static_cast<char>(drawCount));
+}
+
+void BinaryRecordWriter::write(const DealRecord& record) {
+  char bytes[recordSize];
+  putLittleEndian(bytes, record.seed, 8);
+  putLittleEndian(bytes + 8, record.outcome, 1);
+  putLittleEndian(bytes + 9, record.solutionLength, 4);
+  putLittleEndian(bytes + 13, record.nodes, 8);
+  putLittleEndian(bytes + 21, std::llround(record.seconds * 1e6), 8);
+  out_.write(bytes, recordSize);
+}
+
+bool readBinaryHeader(std::istream& in, int& drawCount) {
+  char header[sizeof(binaryMagic) + 1];
+  if (!in.read(header, sizeof(header)) ||
+      !std::equal(binaryMagic, binaryMagic + sizeof(binaryMagic), header)) {
+    return false;
+  }
+  drawCount = header[sizeof(binaryMagic)];
+  return true;
+}
+
+bool readBinaryRecord(std::istream& in, DealRecord& record) {
+  char bytes[BinaryRecordWriter::recordSize];
+  if (!in.read(bytes, sizeof(bytes))) {
+    return false;
+  }
+  record.seed = getLittleEndian(bytes, 8);
+  record.outcome = static_cast<Outcome>(getLittleEndian(bytes + 8, 1));
+  record.solutionLength = getLittleEndian(bytes + 9, 4);
+  record.nodes = getLittleEndian(bytes + 13, 8);
+  record.seconds = getLittleEndian(bytes + 21, 8) / 1e6;
+  return true;
+}
+
+void analyzeDeals(uint64_t firstSeed, uint64_t lastSeed, int drawCount,
+                  const SolverLimits& limits, int threads,
+                  DealRecordWriter& writer, SolverCache* cache,
+                  int solverThreads) {
+  if (threads <= 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  std::atomic<uint64_t> nextSeed(firstSeed);
+  std::mutex writerMutex;
+  auto work = [&]() {
+    while (true) {
+      const uint64_t seed = nextSeed++;
+      if (seed > lastSeed || seed < firstSeed) {
+        break;  // Done, or the counter wrapped around
+      }
+      const DealRecord record =
+          analyzeDeal(seed, drawCount, limits, cache, solverThreads);
+      std::lock_guard<std::mutex> lock(writerMutex);
+      writer.write(record);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+}
@@ -0,0 +1,139 @@
+#ifndef DEAL_ANALYSIS_HPP
+#define DEAL_ANALYSIS_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "engine/solver.hpp"
+#include "engine/solverCache.hpp"
+
+/**
+ * @brief Solver result of one deal, as written by the analysis tools.
+ */
+struct DealRecord {
+  uint64_t seed = 0;            ///< Deal number the deal was shuffled with.
+  Outcome outcome = UNDECIDED;  ///< Whether the deal can be won.
+  uint32_t solutionLength = 0;  ///< Number of moves of the solution found.
+  uint64_t nodes = 0;           ///< Number of positions the solver expanded.
+  double seconds = 0;           ///< Wall time spent on the deal.
+  std::vector<WorkerStats> workers;  ///< Statistics per solver thread.
+};
+
+/**
+ * @brief Solve the deal shuffled with a seed, as dealt by Game::startGame.
+ * @param seed Deal number passed to shuffledDeck.
+ * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+ * @param limits Bounds on the search of the deal.
+ * @param cache Cache to take the result from, and to store new results in.
+ * @param solverThreads Threads searching the deal: 1 for Solver, otherwise a
+ * ParallelSolver with that many threads, 0 for one per hardware thread.
+ * @return The record of the deal. Cached deals take no time and report the
+ * nodes of the search that solved them, without worker statistics.
+ */
+DealRecord analyzeDeal(uint64_t seed, int drawCount,
+                       const SolverLimits& limits,
+                       SolverCache* cache = nullptr, int solverThreads = 1);
+
+/**
+ * @class DealRecordWriter
+ * @brief Destination of deal records. Abstract base class.
+ */
+class DealRecordWriter {
+ public:
+  virtual ~DealRecordWriter() = default;
+
+  /**
+   * @brief Write one record.
+   * @param record The record to write.
+   */
+  virtual void write(const DealRecord& record) = 0;
+};
+
+/**
+ * @class CsvRecordWriter
+ * @brief Writes records as CSV lines after a header line.
+ *
+ * Columns: seed, result (win, loss or unknown), solution length, nodes and
+ * seconds.
+ */
+class CsvRecordWriter : public DealRecordWriter {
+ public:
+  /**
+   * @brief Construct a writer and write the header line.
+   * @param out The stream to write to.
+   */
+  explicit CsvRecordWriter(std::ostream& out);
+
+  void write(const DealRecord& record) override;
+
+ private:
+  std::ostream& out_;  ///< The stream to write to.
+};
+
+/**
+ * @class BinaryRecordWriter
+ * @brief Writes records in a compact binary format.
+ *
+ * The file starts with the 4 bytes "KSA1" and the draw count as one byte.
+ * Each record then takes 29 bytes, all integers little-endian: the seed
+ * (8 bytes), the outcome (1), the solution length (4), the nodes (8) and the
+ * wall time in microseconds (8).
+ */
+class BinaryRecordWriter : public DealRecordWriter {
+ public:
+  static constexpr int recordSize = 29;  ///< Size of a record in bytes.
+
+  /**
+   * @brief Construct a writer and write the file header.
+   * @param out The stream to write to, opened in binary mode.
+   * @param drawCount Draw count of the deals, stored in the header.
+   */
+  BinaryRecordWriter(std::ostream& out, int drawCount);
+
+  void write(const DealRecord& record) override;
+
+ private:
+  std::ostream& out_;  ///< The stream to write to.
+};
+
+/**
+ * @brief Read the header written by BinaryRecordWriter.
+ * @param in The stream to read from.
+ * @param drawCount Set to the draw count stored in the header.
+ * @return False if the stream does not start with a valid header.
+ */
+bool readBinaryHeader(std::istream& in, int& drawCount);
+
+/**
+ * @brief Read one record written by BinaryRecordWriter.
+ * @param in The stream to read from, past the header.
+ * @param record Set to the record read.
+ * @return False at the end of the stream.
+ */
+bool readBinaryRecord(std::istream& in, DealRecord& record);
+
+/**
+ * @brief Solve a range of deals on several threads.
+ *
+ * Each thread takes the next unsolved seed and solves it, by default with a
+ * single-threaded Solver, which scales better over many deals than splitting
+ * each search. Splitting pays off for a few hard deals. Records are written
+ * as deals finish, so not in seed order.
+ *
+ * @param firstSeed First seed of the range.
+ * @param lastSeed Last seed of the range, included.
+ * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+ * @param limits Bounds on the search of each deal.
+ * @param threads Number of threads, 0 for one per hardware thread.
+ * @param writer Destination of the records, called from one thread at a time.
+ * @param cache Cache shared by the threads, see analyzeDeal.
+ * @param solverThreads Threads searching each deal, see analyzeDeal.
+ */
+void analyzeDeals(uint64_t firstSeed, uint64_t lastSeed, int drawCount,
+                  const SolverLimits& limits, int threads,
+                  DealRecordWriter& writer, SolverCache* cache = nullptr,
+                  int solverThreads = 1);
+
+#endif  // DEAL_ANALYSIS_HPP
@@ -0,0 +1,123 @@
+#include "engine/dealGenerator.hpp"
+
+#include <iterator>
+
+#include "engine/deal.hpp"
+#include "engine/dealAnalysis.hpp"
+
+// Deals the solver proves winnable in a few hundred nodes, handed out while
+// the queue is empty. Checked by the DealGenerator tests.
+static const uint64_t knownDrawOne[] = {1,  2,  3,  5,  11, 12, 14, 15,
+                                        16, 18, 22, 23, 24, 28, 31, 33};
+static const uint64_t knownDrawThree[] = {1,  2,  5,  11, 12, 15, 17, 18,
+                                          22, 23, 24, 28, 33, 36, 41, 47};
+
+DealGenerator::DealGenerator(SolverCache* cache, size_t queueSize,
+                             double maxSeconds)
+    : cache_(cache),
+      queueSize_(queueSize),
+      drawCount_(1),
+      generation_(0),
+      active_(false),
+      stop_(false),
+      cancelled_(false) {
+  limits_.maxSeconds = maxSeconds;
+  limits_.cancel = &cancelled_;
+  thread_ = std::thread(&DealGenerator::run, this);
+}
+
+DealGenerator::~DealGenerator() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    cancelled_ = true;
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void DealGenerator::start(int drawCount) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (drawCount != drawCount_) {
+      queue_.clear();
+      drawCount_ = drawCount;
+      generation_++;
+      cancelled_ = true;
+    }
+    active_ = true;
+  }
+  cv_.notify_one();
+}
+
+void DealGenerator::stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  active_ = false;
+  cancelled_ = true;
+}
+
+uint64_t DealGenerator::next() {
+  int drawCount;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!queue_.empty()) {
+      const uint64_t dealNumber = queue_.front();
+      queue_.pop_front();
+      cv_.notify_one();
+      return dealNumber;
+    }
+    drawCount = drawCount_;
+  }
+  // Nothing solved yet, deal one of the deals known to be winnable
+  size_t count;
+  const uint64_t* known = knownDeals(drawCount, count);
+  return known[randomDealNumber() % count];
+}
+
+const uint64_t* DealGenerator::knownDeals(int drawCount, size_t& count) {
+  if (drawCount == 3) {
+    count = std::size(knownDrawThree);
+    return knownDrawThree;
+  }
+  count = std::size(knownDrawOne);
+  return knownDrawOne;
+}
+
+size_t DealGenerator::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return queue_.size();
+}
+
+int DealGenerator::getDrawCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return drawCount_;
+}
+
+void DealGenerator::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this]() {
+      return stop_ || (active_ && queue_.size() < queueSize_);
+    });
+    if (stop_) {
+      return;
+    }
+    const int drawCount = drawCount_;
+    const uint64_t generation = generation_;
+    cancelled_ = false;
+    lock.unlock();
+
+    const uint64_t dealNumber = randomDealNumber();
+    const DealRecord record =
+        analyzeDeal(dealNumber, drawCount, limits_, cache_);
+
+    lock.lock();
+    // Drop deals solved for a draw count that is no longer wanted
+    if (record.outcome == WINNABLE && generation == generation_ &&
+        queue_.size() < queueSize_) {
+      queue_.push_back(dealNumber);
+    }
+  }
+}
@@ -0,0 +1,112 @@
+#ifndef DEAL_GENERATOR_HPP
+#define DEAL_GENERATOR_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "engine/solver.hpp"
+#include "engine/solverCache.hpp"
+
+/**
+ * @class DealGenerator
+ * @brief Keeps a queue of proven winnable deals, solved on a background
+ * thread.
+ *
+ * While started, the worker thread draws random deal numbers and solves them
+ * with analyzeDeal until the queue is full, keeping only the deals it proves
+ * winnable. Taking a deal never waits for a search: when the queue is empty,
+ * for example right after launch, a deal from a short built-in list of deals
+ * proven winnable is handed out instead. Every deal handed out is proven
+ * winnable for the generator's draw count.
+ *
+ * The queue is for one draw count; starting with another one empties it.
+ */
+class DealGenerator {
+ public:
+  static constexpr size_t defaultQueueSize = 4;  ///< Deals kept ready.
+  static constexpr double defaultSeconds = 2;    ///< Search time per deal.
+
+  /**
+   * @brief Construct a stopped generator and its worker thread.
+   * @param cache Cache the solved deals are read from and stored in, so the
+   * game finds their solutions, or nullptr for none. Must outlive the
+   * generator.
+   * @param queueSize Number of deals to keep ready.
+   * @param maxSeconds Time budget of the search of one deal. Deals not
+   * solved in time are skipped.
+   */
+  explicit DealGenerator(SolverCache* cache = nullptr,
+                         size_t queueSize = defaultQueueSize,
+                         double maxSeconds = defaultSeconds);
+
+  /**
+   * @brief Stop the search in flight and the worker thread.
+   */
+  ~DealGenerator();
+
+  DealGenerator(const DealGenerator&) = delete;
+  DealGenerator& operator=(const DealGenerator&) = delete;
+
+  /**
+   * @brief Start filling the queue.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * The queue is emptied if it holds deals for the other draw count.
+   */
+  void start(int drawCount);
+
+  /**
+   * @brief Stop filling the queue, keeping the deals already in it.
+   */
+  void stop();
+
+  /**
+   * @brief Take the oldest winnable deal, without waiting.
+   * @return The deal number, see shuffledDeck. A built-in winnable deal if
+   * the queue is empty.
+   */
+  uint64_t next();
+
+  /**
+   * @brief Get the built-in deals that are proven winnable.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * @param count Set to the number of deals.
+   * @return The deal numbers.
+   */
+  static const uint64_t* knownDeals(int drawCount, size_t& count);
+
+  /**
+   * @brief Get the number of deals ready.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Get the draw count the queued deals were solved for.
+   */
+  int getDrawCount() const;
+
+ private:
+  SolverCache* cache_;           ///< Cache of solved deals, or nullptr.
+  const size_t queueSize_;       ///< Number of deals to keep ready.
+  SolverLimits limits_;          ///< Bounds on the search of one deal.
+  mutable std::mutex mutex_;     ///< Guards the members below.
+  std::condition_variable cv_;   ///< Wakes the worker.
+  std::deque<uint64_t> queue_;   ///< Winnable deal numbers, oldest first.
+  int drawCount_;                ///< Draw count of the queued deals.
+  uint64_t generation_;          ///< Bumped when the draw count changes.
+  bool active_;                  ///< Whether the queue is being filled.
+  bool stop_;                    ///< Whether the worker should exit.
+  std::atomic<bool> cancelled_;  ///< Stops the search in flight.
+  std::thread thread_;           ///< The worker thread.
+
+  /**
+   * @brief Worker loop: solve random deals while the queue has room.
+   */
+  void run();
+};
+
+#endif  // DEAL_GENERATOR_HPP
@@ -0,0 +1,156 @@
+#include "engine/dealId.hpp"
+
+#include "engine/moveTables.hpp"
+
+// Multiply a number by a small factor and add a small term.
+static void mulAdd(DealId& id, uint32_t factor, uint32_t term) {
+  uint64_t carry = term;
+  for (uint64_t& word : id.words) {
+    // Split each word in halves so that no product overflows
+    const uint64_t low = (word & 0xffffffffull) * factor + carry;
+    const uint64_t high = (word >> 32) * factor + (low >> 32);
+    word = (high << 32) | (low & 0xffffffffull);
+    carry = high >> 32;
+  }
+}
+
+// Divide a number by a small divisor in place and return the remainder.
+static uint32_t divMod(DealId& id, uint32_t divisor) {
+  uint64_t remainder = 0;
+  for (int i = DealId::wordAm - 1; i >= 0; i--) {
+    const uint64_t high = (remainder << 32) | (id.words[i] >> 32);
+    const uint64_t low = ((high % divisor) << 32) | (id.words[i] & 0xffffffff);
+    id.words[i] = ((high / divisor) << 32) | (low / divisor);
+    remainder = low % divisor;
+  }
+  return remainder;
+}
+
+// Index of the n-th lowest card of a mask, counting from 0.
+static int nthCard(uint64_t mask, int n) {
+  // Skip whole bytes first, then single cards
+  int base = 0;
+  for (int count = cardCount(mask & 0xff); count <= n;
+       count = cardCount(mask & 0xff)) {
+    n -= count;
+    mask >>= 8;
+    base += 8;
+  }
+  for (; n > 0; n--) {
+    mask &= mask - 1;
+  }
+  return base + lowestCard(mask);
+}
+
+// 52!, the number of orders.
+static const DealId& orderAm() {
+  static const DealId count = []() {
+    DealId id;
+    id.words[0] = 1;
+    for (uint32_t i = 2; i <= DECK_SIZE; i++) {
+      mulAdd(id, i, 0);
+    }
+    return id;
+  }();
+  return count;
+}
+
+bool DealId::operator==(const DealId& other) const {
+  for (int i = 0; i < wordAm; i++) {
+    if (words[i] != other.words[i]) return false;
+  }
+  return true;
+}
+
+bool DealId::operator<(const DealId& other) const {
+  for (int i = wordAm - 1; i >= 0; i--) {
+    if (words[i] != other.words[i]) return words[i] < other.words[i];
+  }
+  return false;
+}
+
+bool DealId::isValid() const { return *this < orderAm(); }
+
+std::string DealId::toString() const {
+  static const char digits[] = "0123456789abcdef";
+  std::string text(hexDigits, '0');
+  for (int i = 0; i < hexDigits; i++) {
+    text[hexDigits - 1 - i] = digits[(words[i / 16] >> (4 * (i % 16))) & 0xf];
+  }
+  return text;
+}
+
+bool DealId::fromString(const std::string& text, DealId& id) {
+  if (text.empty() || text.size() > static_cast<size_t>(hexDigits)) {
+    return false;
+  }
+  DealId parsed;
+  for (char c : text) {
+    int digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      digit = c - 'A' + 10;
+    } else {
+      return false;
+    }
+    mulAdd(parsed, 16, digit);
+  }
+  if (!parsed.isValid()) {
+    return false;
+  }
+  id = parsed;
+  return true;
+}
+
+DealId rankDeal(const std::vector<CardState>& cards) {
+  // Lehmer code: each digit counts the unused cards below the card, and the
+  // digits are read as a number in the factorial base
+  uint64_t unused = cardBit(DECK_SIZE) - 1;
+  DealId id;
+  for (int i = 0; i < DECK_SIZE; i++) {
+    const int index = cards[i].getIndex();
+    const int digit = cardCount(unused & (cardBit(index) - 1));
+    unused &= ~cardBit(index);
+    mulAdd(id, DECK_SIZE - i, digit);
+  }
+  return id;
+}
+
+std::vector<CardState> unrankDeal(const DealId& id) {
+  int digits[DECK_SIZE];
+  DealId rest = id;
+  for (int i = DECK_SIZE - 1; i >= 0; i--) {
+    digits[i] = divMod(rest, DECK_SIZE - i);
+  }
+
+  uint64_t unused = cardBit(DECK_SIZE) - 1;
+  std::vector<CardState> cards;
+  cards.reserve(DECK_SIZE);
+  for (int i = 0; i < DECK_SIZE; i++) {
+    const int index = nthCard(unused, digits[i]);
+    unused &= ~cardBit(index);
+    cards.push_back(CardState::fromIndex(index));
+  }
+  return cards;
+}
+
+DealId randomDealId(DealRandom& random) {
+  DealId id;
+  for (int i = 0; i < DECK_SIZE; i++) {
+    mulAdd(id, DECK_SIZE - i, random.below(DECK_SIZE - i));
+  }
+  return id;
+}
+
+bool nextDealId(DealId& id) {
+  DealId next = id;
+  mulAdd(next, 1, 1);
+  if (!next.isValid()) {
+    return false;
+  }
+  id = next;
+  return true;
+}
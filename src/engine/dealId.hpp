@@ -0,0 +1,79 @@
+#ifndef DEAL_ID_HPP
+#define DEAL_ID_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/cardState.hpp"
+#include "engine/random.hpp"
+
+/**
+ * @struct DealId
+ * @brief Number of a 52 card order among all 52! orders.
+ *
+ * The number is the rank of the order in lexicographic order of card
+ * indices, computed from its Lehmer code, so it is below 52! < 2^226 and
+ * fits in four 64-bit words. The sorted deck has id 0. Unlike a deal number,
+ * which picks a deal through the shuffle, a DealId stands for any order, and
+ * each order has exactly one.
+ */
+struct DealId {
+  static constexpr int wordAm = 4;  ///< Number of 64-bit words.
+  static constexpr int hexDigits = 57;  ///< Hex digits of the largest id.
+
+  uint64_t words[wordAm] = {0, 0, 0, 0};  ///< The number, low word first.
+
+  bool operator==(const DealId& other) const;
+  bool operator!=(const DealId& other) const { return !(*this == other); }
+  bool operator<(const DealId& other) const;
+
+  /**
+   * @brief Check whether the id is below 52! and so stands for an order.
+   */
+  bool isValid() const;
+
+  /**
+   * @brief Get the id as a fixed-width hexadecimal string.
+   * @return hexDigits lowercase hex digits, most significant first.
+   */
+  std::string toString() const;
+
+  /**
+   * @brief Parse an id written by toString.
+   * @param text Up to hexDigits hex digits, most significant first.
+   * @param id Set to the parsed id.
+   * @return False if the text is not a valid id.
+   */
+  static bool fromString(const std::string& text, DealId& id);
+};
+
+/**
+ * @brief Get the id of a card order, in O(52).
+ * @param cards All 52 cards in any order; faces are ignored.
+ * @return The id of the order.
+ */
+DealId rankDeal(const std::vector<CardState>& cards);
+
+/**
+ * @brief Get the card order of an id, in O(52). Inverse of rankDeal.
+ * @param id A valid id.
+ * @return The 52 cards face down, in the order of the id.
+ */
+std::vector<CardState> unrankDeal(const DealId& id);
+
+/**
+ * @brief Draw an id uniformly among all 52! orders.
+ * @param random The generator, which gives the same ids on every platform.
+ * @return The id.
+ */
+DealId randomDealId(DealRandom& random);
+
+/**
+ * @brief Step to the id of the next order, for enumerating orders.
+ * @param id A valid id, incremented in place.
+ * @return False if id was the last order, 52! - 1, and is left unchanged.
+ */
+bool nextDealId(DealId& id);
+
+#endif  // DEAL_ID_HPP
@@ -0,0 +1,275 @@
+#include "engine/difficulty.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <sstream>
+#include <string>
+
+#include "engine/deal.hpp"
+#include "engine/dealAnalysis.hpp"
+#include "engine/gameState.hpp"
+
+static const int maxPlayoutMoves = 500;  ///< Moves before a playout gives up.
+
+static const char* const outcomeNames[] = {"win", "loss", "unknown"};
+
+static double clamp01(double value) {
+  return std::min(1.0, std::max(0.0, value));
+}
+
+double difficultyScore(const DifficultyRating& rating) {
+  if (rating.outcome == UNWINNABLE) {
+    return 100;
+  }
+  const double effort =
+      clamp01((std::log10(static_cast<double>(rating.nodes) + 1) - 2) / 4);
+  // A deal the solver gave up on counts as having the longest solution
+  const double length =
+      rating.outcome == UNDECIDED
+          ? 1
+          : clamp01((rating.solutionLength - 80.0) / 100);
+  const double luck =
+      rating.playouts == 0
+          ? 0
+          : static_cast<double>(rating.randomWins) / rating.playouts;
+  return 40 * effort + 30 * length + 30 * (1 - luck);
+}
+
+// Play random moves, target moves first, until won or out of moves.
+static bool randomPlayout(GameState state, DealRandom& random) {
+  MoveList moves;
+  for (int i = 0; i < maxPlayoutMoves; i++) {
+    if (state.hasWon()) {
+      return true;
+    }
+    moves.size = 0;
+    state.legalMoves(moves);
+    if (moves.empty()) {
+      return false;
+    }
+    const BoardMove* chosen = nullptr;
+    for (const BoardMove& move : moves) {
+      if (Board::isTarget(move.toPile_)) {
+        chosen = &move;
+        break;
+      }
+    }
+    if (chosen == nullptr) {
+      chosen = &moves.moves[random.below(moves.size)];
+    }
+    state.applyMove(*chosen);
+  }
+  return state.hasWon();
+}
+
+DifficultyRating rateDeal(uint64_t seed, int drawCount,
+                          const SolverLimits& limits, int playouts,
+                          SolverCache* cache) {
+  const DealRecord record = analyzeDeal(seed, drawCount, limits, cache);
+  DifficultyRating rating;
+  rating.outcome = record.outcome;
+  rating.nodes = record.nodes;
+  rating.solutionLength = record.solutionLength;
+
+  if (record.outcome != UNWINNABLE) {
+    const GameState state(shuffledDeck(seed), drawCount == 3);
+    DealRandom random(splitMix64(seed));
+    for (int i = 0; i < playouts; i++) {
+      rating.randomWins += randomPlayout(state, random);
+    }
+    rating.playouts = playouts;
+  }
+  rating.score = difficultyScore(rating);
+  return rating;
+}
+
+DifficultyRater::DifficultyRater(int threads, const SolverLimits& limits,
+                                 int playouts, size_t queueSize,
+                                 SolverCache* cache)
+    : limits_(limits),
+      playouts_(playouts),
+      queueSize_(queueSize),
+      cache_(cache),
+      busy_(0),
+      stop_(false),
+      cancel_(false) {
+  if (threads <= 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (int i = 0; i < threads; i++) {
+    threads_.emplace_back(&DifficultyRater::run, this);
+  }
+}
+
+DifficultyRater::~DifficultyRater() { stop(); }
+
+void DifficultyRater::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+    queue_.clear();
+  }
+  cancel_ = true;
+  workCv_.notify_all();
+  doneCv_.notify_all();
+  for (std::thread& thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+SolverLimits DifficultyRater::defaultLimits() {
+  SolverLimits limits;
+  limits.maxSeconds = 2;
+  return limits;
+}
+
+bool DifficultyRater::find(const DealId& id, int drawCount,
+                           DifficultyRating& rating) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = ratings_.find(Key(id, drawCount));
+  if (found == ratings_.end()) {
+    return false;
+  }
+  rating = found->second;
+  return true;
+}
+
+bool DifficultyRater::request(uint64_t seed, int drawCount,
+                              Callback onDone) {
+  DifficultyRating rating;
+  if (find(rankDeal(shuffledDeck(seed)), drawCount, rating)) {
+    if (onDone) {
+      onDone(rating);
+    }
+    return true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_ || queue_.size() >= queueSize_) {
+      return false;
+    }
+    queue_.push_back({seed, drawCount, std::move(onDone)});
+  }
+  workCv_.notify_one();
+  return true;
+}
+
+void DifficultyRater::rate(uint64_t seed, int drawCount) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock,
+                 [this]() { return stop_ || queue_.size() < queueSize_; });
+    if (stop_) {
+      return;
+    }
+    queue_.push_back({seed, drawCount, nullptr});
+  }
+  workCv_.notify_one();
+}
+
+void DifficultyRater::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  doneCv_.wait(lock, [this]() { return queue_.empty() && busy_ == 0; });
+}
+
+size_t DifficultyRater::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return ratings_.size();
+}
+
+void DifficultyRater::save(std::ostream& out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  out << "deal_id,draw,score,result,nodes,solution_length,random_wins,"
+         "playouts,solver\n";
+  for (const auto& [key, rating] : ratings_) {
+    out << key.first.toString() << ',' << key.second << ',' << rating.score
+        << ',' << outcomeNames[rating.outcome] << ',' << rating.nodes << ','
+        << rating.solutionLength << ',' << rating.randomWins << ','
+        << rating.playouts << ',' << Solver::version << '\n';
+  }
+}
+
+bool DifficultyRater::load(std::istream& in) {
+  std::string line;
+  if (!std::getline(in, line) || line.rfind("deal_id,", 0) != 0) {
+    return false;
+  }
+  std::map<Key, DifficultyRating> loaded;
+  while (std::getline(in, line)) {
+    std::istringstream lineStream(line);
+    std::string cells[9];
+    int cellAm = 0;
+    while (cellAm < 9 && std::getline(lineStream, cells[cellAm], ',')) {
+      cellAm++;
+    }
+    DealId id;
+    if (cellAm < 8 || !DealId::fromString(cells[0], id)) {
+      return false;
+    }
+    // Ratings without a solver column predate the versions. Other solvers
+    // may have proven winnable deals lost, so rate those deals again.
+    if (cellAm != 9 || cells[8] != std::to_string(Solver::version)) {
+      continue;
+    }
+    const auto outcome =
+        std::find(std::begin(outcomeNames), std::end(outcomeNames), cells[3]);
+    if (outcome == std::end(outcomeNames)) {
+      return false;
+    }
+    DifficultyRating rating;
+    rating.outcome = static_cast<Outcome>(outcome - std::begin(outcomeNames));
+    try {
+      rating.score = std::stod(cells[2]);
+      rating.nodes = std::stoull(cells[4]);
+      rating.solutionLength = std::stoul(cells[5]);
+      rating.randomWins = std::stoul(cells[6]);
+      rating.playouts = std::stoul(cells[7]);
+      loaded[Key(id, std::stoi(cells[1]))] = rating;
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+  // Ratings computed in this process are never replaced by the file's
+  std::lock_guard<std::mutex> lock(mutex_);
+  ratings_.merge(loaded);
+  return true;
+}
+
+void DifficultyRater::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    workCv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (stop_) {
+      return;
+    }
+    Job job = std::move(queue_.front());
+    queue_.pop_front();
+    busy_++;
+    doneCv_.notify_all();
+    lock.unlock();
+
+    const DealId id = rankDeal(shuffledDeck(job.seed));
+    SolverLimits limits = limits_;
+    limits.cancel = &cancel_;
+    const DifficultyRating rating =
+        rateDeal(job.seed, job.drawCount, limits, playouts_, cache_);
+
+    // A search cut short by stop() did not rate the deal
+    lock.lock();
+    const bool stopped = stop_;
+    if (!stopped) {
+      ratings_[Key(id, job.drawCount)] = rating;
+    }
+    lock.unlock();
+    if (!stopped && job.onDone) {
+      job.onDone(rating);
+    }
+
+    lock.lock();
+    busy_--;
+    doneCv_.notify_all();
+  }
+}
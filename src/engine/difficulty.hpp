@@ -0,0 +1,212 @@
+#ifndef DIFFICULTY_HPP
+#define DIFFICULTY_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "engine/dealId.hpp"
+#include "engine/solver.hpp"
+#include "engine/solverCache.hpp"
+
+/**
+ * @brief How hard a deal is, with the measures the score is made of.
+ */
+struct DifficultyRating {
+  double score = 0;             ///< 0 for the easiest deals, 100 if lost.
+  Outcome outcome = UNDECIDED;  ///< Whether the deal can be won.
+  uint64_t nodes = 0;           ///< Positions the solver expanded.
+  uint32_t solutionLength = 0;  ///< Number of moves of the solution found.
+  uint32_t randomWins = 0;      ///< Random playouts that won.
+  uint32_t playouts = 0;        ///< Random playouts played.
+};
+
+/**
+ * @brief Combine the measures of a rating into its score.
+ *
+ * Solver effort weighs 40 points, on a log scale from 100 to 1,000,000
+ * nodes. Solution length weighs 30 points, from 80 to 180 moves, all of them
+ * if the solver ran out of time. The share of random playouts lost weighs the
+ * last 30 points. Unwinnable deals score 100.
+ *
+ * @param rating The rating, its score is ignored.
+ * @return The score, from 0 to 100.
+ */
+double difficultyScore(const DifficultyRating& rating);
+
+/**
+ * @brief Rate the deal shuffled with a seed.
+ *
+ * Random playouts take a move to a target pile when there is one and any
+ * legal move otherwise. They are seeded with the deal number, so a deal
+ * always gets the same rating.
+ *
+ * @param seed Deal number passed to shuffledDeck.
+ * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+ * @param limits Bounds on the search of the deal.
+ * @param playouts Number of random playouts.
+ * @param cache Cache of solver results, see analyzeDeal.
+ * @return The rating.
+ */
+DifficultyRating rateDeal(uint64_t seed, int drawCount,
+                          const SolverLimits& limits, int playouts,
+                          SolverCache* cache = nullptr);
+
+/**
+ * @class DifficultyRater
+ * @brief Rates deals on a bounded pool of threads and keeps the ratings by
+ * deal id.
+ *
+ * At most a fixed number of deals wait to be rated; requests beyond it are
+ * refused rather than queued, so a caller can never pile up work. Ratings
+ * can be saved as CSV, for example by solitaire_analyze over a range of
+ * seeds, and loaded back so that known deals are never rated again.
+ */
+class DifficultyRater {
+ public:
+  /**
+   * @brief Function called on a pool thread with a finished rating.
+   */
+  using Callback = std::function<void(const DifficultyRating&)>;
+
+  static constexpr int defaultPlayouts = 32;     ///< Playouts per deal.
+  static constexpr size_t defaultQueueSize = 16;  ///< Deals waiting at most.
+
+  /**
+   * @brief Construct the rater and start its threads.
+   * @param threads Number of threads, 0 for one per hardware thread.
+   * @param limits Bounds on the search of each deal.
+   * @param playouts Number of random playouts per deal.
+   * @param queueSize Number of deals that may wait to be rated.
+   * @param cache Cache of solver results, see analyzeDeal.
+   */
+  explicit DifficultyRater(int threads = 1,
+                           const SolverLimits& limits = defaultLimits(),
+                           int playouts = defaultPlayouts,
+                           size_t queueSize = defaultQueueSize,
+                           SolverCache* cache = nullptr);
+
+  /**
+   * @brief Drop the waiting deals and stop the threads, see stop.
+   */
+  ~DifficultyRater();
+
+  DifficultyRater(const DifficultyRater&) = delete;
+  DifficultyRater& operator=(const DifficultyRater&) = delete;
+
+  /**
+   * @brief Get the default bounds on the search of a deal: 2 seconds.
+   */
+  static SolverLimits defaultLimits();
+
+  /**
+   * @brief Look up the rating of a deal.
+   * @param id Id of the deal's card order.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * @param rating Set to the rating if known.
+   * @return True if the deal has been rated.
+   */
+  bool find(const DealId& id, int drawCount, DifficultyRating& rating) const;
+
+  /**
+   * @brief Rate a deal in the background, without waiting.
+   * @param seed Deal number passed to shuffledDeck.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * @param onDone Called on a pool thread with the rating. Called right away
+   * if the deal has been rated before.
+   * @return False if the queue is full or the rater is stopped, and the deal
+   * is not rated.
+   */
+  bool request(uint64_t seed, int drawCount, Callback onDone = nullptr);
+
+  /**
+   * @brief Rate a deal in the background, waiting for room in the queue.
+   * @param seed Deal number passed to shuffledDeck.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   */
+  void rate(uint64_t seed, int drawCount);
+
+  /**
+   * @brief Wait until every requested deal is rated.
+   */
+  void wait();
+
+  /**
+   * @brief Drop the waiting deals, cut the searches in flight short and stop
+   * the threads.
+   *
+   * Deals whose search was cut short are not rated and their callbacks are
+   * not called. Once this returns no callback runs, so the caller can save
+   * the ratings and be torn down. Later requests are refused.
+   */
+  void stop();
+
+  /**
+   * @brief Get the number of deals rated.
+   */
+  size_t size() const;
+
+  /**
+   * @brief Write all ratings as CSV lines after a header line.
+   *
+   * Columns: deal id, draw count, score, result (win, loss or unknown),
+   * nodes, solution length, random wins, playouts and the Solver::version
+   * that rated the deal.
+   *
+   * @param out The stream to write to.
+   */
+  void save(std::ostream& out) const;
+
+  /**
+   * @brief Add the ratings written by save.
+   *
+   * Ratings of other solver versions are skipped, and deals already rated
+   * keep their rating.
+   * @param in The stream to read from.
+   * @return False if the stream does not hold ratings.
+   */
+  bool load(std::istream& in);
+
+ private:
+  using Key = std::pair<DealId, int>;  ///< Deal id and draw count.
+
+  /**
+   * @brief A deal waiting to be rated.
+   */
+  struct Job {
+    uint64_t seed;    ///< Deal number.
+    int drawCount;    ///< Cards drawn at a time.
+    Callback onDone;  ///< Called with the rating, may be empty.
+  };
+
+  const SolverLimits limits_;                ///< Bounds on each search.
+  const int playouts_;                       ///< Random playouts per deal.
+  const size_t queueSize_;                   ///< Deals waiting at most.
+  SolverCache* cache_;                       ///< Solver results, or nullptr.
+  mutable std::mutex mutex_;                 ///< Guards the members below.
+  std::condition_variable workCv_;           ///< Wakes the pool threads.
+  std::condition_variable doneCv_;           ///< Wakes waiting callers.
+  std::deque<Job> queue_;                    ///< Deals waiting to be rated.
+  int busy_;                                 ///< Deals being rated.
+  bool stop_;                                ///< Whether the threads exit.
+  std::atomic<bool> cancel_;                 ///< Cuts the searches short.
+  std::map<Key, DifficultyRating> ratings_;  ///< Ratings by deal.
+  std::vector<std::thread> threads_;         ///< The pool.
+
+  /**
+   * @brief Pool thread loop: rate waiting deals.
+   */
+  void run();
+};
+
+#endif  // DIFFICULTY_HPP
@@ -0,0 +1,48 @@
+#include "engine/foundations.hpp"
+
+#include <algorithm>
+
+Foundations::Foundations() {
+  for (int i = 0; i < TARGET_PILE_AM; i++) {
+    heights_[i] = 0;
+    pileSuits_[i] = -1;
+  }
+  for (Suit suit : allSuits) {
+    safeRanks_[suit] = safeRank(heights_, suit);
+  }
+}
+
+void Foundations::setPile(int target, const CardState* top) {
+  if (top != nullptr) {
+    pileSuits_[target] = top->getSuit();
+    heights_[top->getSuit()] = top->getRank();
+  } else if (pileSuits_[target] >= 0) {
+    heights_[pileSuits_[target]] = 0;
+    pileSuits_[target] = -1;
+  }
+  for (Suit suit : allSuits) {
+    safeRanks_[suit] = safeRank(heights_, suit);
+  }
+}
+
+int Foundations::safeCard(Suit suit) const {
+  const int rank = heights_[suit] + 1;
+  if (rank > KING || rank > safeRanks_[suit]) {
+    return -1;
+  }
+  return cardIndex(suit, static_cast<Rank>(rank));
+}
+
+int Foundations::safeRank(const int heights[], Suit suit) {
+  // A card only ever holds the other color one rank below it, and those
+  // cards may in turn be needed to hold the same color two ranks below
+  int rank = KING;
+  for (Suit other : allSuits) {
+    if (suitColor(other) != suitColor(suit)) {
+      rank = std::min(rank, heights[other] + 1);
+    } else if (other != suit) {
+      rank = std::min(rank, heights[other] + 2);
+    }
+  }
+  return std::max<int>(rank, TWO);
+}
@@ -0,0 +1,73 @@
+#ifndef FOUNDATIONS_HPP
+#define FOUNDATIONS_HPP
+
+#include "engine/cardState.hpp"
+#include "engine/rules.hpp"
+
+/**
+ * @class Foundations
+ * @brief Per-suit heights of the target piles and which cards are safe to
+ * play onto them.
+ *
+ * A card is safe to play to its target pile when no Klondike card can ever
+ * need it: both cards of the other color it could hold are already on the
+ * target piles, and so is the card of its own color two ranks below, which
+ * those cards could still need to hold. A 4 of hearts is safe once both
+ * black 3s and the 2 of diamonds are up, for example.
+ *
+ * The heights are updated one target pile at a time, so keeping the safe set
+ * current costs the same no matter how many cards are on the table.
+ */
+class Foundations {
+ public:
+  /**
+   * @brief Construct with all target piles empty.
+   */
+  Foundations();
+
+  /**
+   * @brief Record the new top card of a target pile.
+   * @param target Number of the target pile, 0 to TARGET_PILE_AM - 1.
+   * @param top The top card, or nullptr if the pile is empty.
+   */
+  void setPile(int target, const CardState* top);
+
+  /**
+   * @brief Get the number of cards of a suit on the target piles.
+   */
+  int getHeight(Suit suit) const { return heights_[suit]; }
+
+  /**
+   * @brief Get the highest rank of a suit that is safe to play.
+   */
+  int getSafeRank(Suit suit) const { return safeRanks_[suit]; }
+
+  /**
+   * @brief Check whether a card is safe to play to its target pile.
+   */
+  bool isSafe(Suit suit, Rank rank) const { return rank <= safeRanks_[suit]; }
+
+  /**
+   * @brief Get the next card of a suit, if it is safe to play.
+   * @param suit The suit.
+   * @return Index of the card one above the suit's height, see cardIndex, or
+   * -1 if the suit is complete or the card is not safe.
+   */
+  int safeCard(Suit suit) const;
+
+  /**
+   * @brief Get the highest rank of a suit that is safe to play.
+   * @param heights Number of cards of each suit on the target piles.
+   * @param suit The suit.
+   * @return The rank, at least TWO since aces and twos never hold a card that
+   * is not on the target piles already.
+   */
+  static int safeRank(const int heights[], Suit suit);
+
+ private:
+  int heights_[TARGET_PILE_AM];    ///< Cards of each suit on the targets.
+  int safeRanks_[TARGET_PILE_AM];  ///< Highest safe rank of each suit.
+  int pileSuits_[TARGET_PILE_AM];  ///< Suit of each target pile, or -1.
+};
+
+#endif  // FOUNDATIONS_HPP
@@ -0,0 +1,158 @@
+#include "engine/gameState.hpp"
+
+#include "engine/deal.hpp"
+
+GameState::GameState(const std::vector<CardState>& deck, bool hardMode)
+    : points_(0), moves_(0), hardMode_(hardMode) {
+  PileState& deckPile = board_.piles[deckIndex];
+  for (auto card : deck) {
+    if (card.isFaceUp()) card.flip();
+    deckPile.addCard(card);
+  }
+
+  // Deal like Game::startGame
+  for (int i = 0; i < KLONDIKE_PILE_AM; i++) {
+    PileState& klondikePile = board_.piles[firstKlondikeIndex + i];
+    for (int j = 0; j <= i && !deckPile.isEmpty(); j++) {
+      deckPile.transferCards(klondikePile);
+    }
+    klondikePile.flipTopCard(true);
+  }
+  moveGen_.reset(board_);
+}
+
+GameState::GameState(uint64_t dealNumber, bool hardMode)
+    : GameState(shuffledDeck(dealNumber), hardMode) {}
+
+MoveType GameState::determineMove(int fromPile, int toPile) const {
+  return Board::moveType(fromPile, toPile);
+}
+
+int GameState::attemptMove(int fromPile, int nofCards, int toPile) {
+  if (fromPile == toPile || fromPile < 0 || fromPile >= pileAm ||
+      toPile < 0 || toPile >= pileAm || nofCards < 1) {
+    return 0;
+  }
+  PileState& from = board_.piles[fromPile];
+  PileState& to = board_.piles[toPile];
+
+  // Only Klondike piles can move more than one card, and only to Klondike
+  const bool multiple = nofCards > 1;
+  if (multiple &&
+      (from.getKind() != KLONDIKE_PILE || to.getKind() != KLONDIKE_PILE)) {
+    return 0;
+  }
+  const CardState* card = from.getCardFromBack(nofCards - 1);
+  if (card == nullptr || !to.isValid(*card)) {
+    return 0;
+  }
+  const MoveType type = determineMove(fromPile, toPile);
+  if (type == UNKNOWN) {
+    return 0;
+  }
+
+  from.transferCards(to, nofCards);
+  logMove({type, fromPile, toPile, nofCards, pointChange(type)});
+
+  // Determine if top card is flipped in KlondikePile.
+  if (from.getKind() == KLONDIKE_PILE && from.flipTopCard(true)) {
+    movehistory_.push_back({FLIP_KLONDIKE, fromPile, toPile, 0,
+                            MovePoints::turnOverPoints});
+    points_ += MovePoints::turnOverPoints;
+  }
+  moveGen_.update(board_, fromPile);
+  moveGen_.update(board_, toPile);
+  return nofCards;
+}
+
+int GameState::attemptDeckMove() {
+  PileState& deck = board_.piles[deckIndex];
+  PileState& waste = board_.piles[wasteIndex];
+  if (!deck.isEmpty()) {
+    int amount = hardMode_ ? 3 : 1;
+    int i = 0;
+    while (i < amount && !deck.isEmpty()) {
+      deck.flipTopCard(true);
+      deck.transferCards(waste);
+      i++;
+    }
+    logMove({DECK_TO_WASTE, deckIndex, wasteIndex, i,
+             MovePoints::dToWPoints});
+    moveGen_.update(board_, deckIndex);
+    moveGen_.update(board_, wasteIndex);
+    return i;
+  } else if (!waste.isEmpty()) {
+    while (!waste.isEmpty()) {
+      waste.flipTopCard(false);
+      waste.transferCards(deck);
+    }
+    logMove(
+        {RECYCLE_DECK, wasteIndex, deckIndex, 0, pointChange(RECYCLE_DECK)});
+    moveGen_.update(board_, deckIndex);
+    moveGen_.update(board_, wasteIndex);
+    return -1;
+  }
+  return 0;
+}
+
+void GameState::logMove(const StateMove& move) {
+  movehistory_.push_back(move);
+  moves_++;
+  points_ += move.pointChange_;
+}
+
+bool GameState::undo() {
+  if (movehistory_.empty()) {
+    return false;
+  }
+  moves_--;
+
+  // Check if card was flipped in KlondikePile
+  if (movehistory_.back().type_ == FLIP_KLONDIKE) {
+    const StateMove& flipMove = movehistory_.back();
+    board_.piles[flipMove.fromPile_].flipTopCard(false);
+    points_ -= flipMove.pointChange_;
+    movehistory_.pop_back();
+  }
+
+  // Get last move
+  const StateMove move = movehistory_.back();
+  movehistory_.pop_back();
+
+  PileState& deck = board_.piles[deckIndex];
+  PileState& waste = board_.piles[wasteIndex];
+  if (move.type_ == RECYCLE_DECK) {
+    while (!deck.isEmpty()) {
+      deck.flipTopCard(true);
+      deck.transferCards(waste);
+    }
+  } else if (move.type_ == DECK_TO_WASTE) {
+    for (int i = 0; i < move.nofCards_ && !waste.isEmpty(); i++) {
+      waste.flipTopCard(false);
+      waste.transferCards(deck);
+    }
+  } else {
+    board_.piles[move.toPile_].transferCards(board_.piles[move.fromPile_],
+                                       move.nofCards_);
+  }
+  points_ -= move.pointChange_;
+  moveGen_.update(board_, move.fromPile_);
+  moveGen_.update(board_, move.toPile_);
+  return true;
+}
+
+int GameState::applyMove(const BoardMove& move) {
+  if (move.type_ == DECK_TO_WASTE || move.type_ == RECYCLE_DECK) {
+    return attemptDeckMove();
+  }
+  return attemptMove(move.fromPile_, move.nofCards_, move.toPile_);
+}
+
+bool GameState::hasWon() const {
+  for (int i = 0; i < TARGET_PILE_AM; i++) {
+    if (getTPile(i).getSize() != 13) {
+      return false;
+    }
+  }
+  return true;
+}
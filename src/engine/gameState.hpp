@@ -0,0 +1,210 @@
+#ifndef GAME_STATE_HPP
+#define GAME_STATE_HPP
+
+#include <vector>
+
+#include "engine/board.hpp"
+#include "engine/moveGenerator.hpp"
+
+/**
+ * @brief A move recorded in the history of a GameState.
+ *
+ * Mirrors the Move struct of Game, with piles referred to by index.
+ */
+struct StateMove {
+  MoveType type_;    ///< The type of the move.
+  int fromPile_;     ///< Index of the pile from which the move originates.
+  int toPile_;       ///< Index of the pile to which the move is made.
+  int nofCards_;     ///< Number of cards involved in the move.
+  int pointChange_;  ///< Points gained or lost by the move.
+};
+
+/**
+ * @class GameState
+ * @brief Qt-free Klondike game: piles, move rules, scoring and undo.
+ *
+ * GameState follows the same rules as Game, Deck, WastePile, KlondikePile and
+ * TargetPile, but holds no graphics, animations or sounds. It can be used to
+ * simulate games in batch jobs and unit tests without a QGuiApplication.
+ *
+ * Piles are referred to by index, see Board.
+ */
+class GameState {
+ public:
+  static constexpr int deckIndex = Board::deckIndex;
+  static constexpr int wasteIndex = Board::wasteIndex;
+  static constexpr int firstKlondikeIndex = Board::firstKlondikeIndex;
+  static constexpr int firstTargetIndex = Board::firstTargetIndex;
+  static constexpr int pileAm = Board::pileAm;
+
+  /**
+   * @brief Construct a game from a deck and deal the Klondike piles.
+   * @param deck The 52 cards of the deck, the last element being the top.
+   * @param hardMode Whether three cards are drawn from the deck at a time.
+   */
+  explicit GameState(const std::vector<CardState>& deck,
+                     bool hardMode = false);
+
+  /**
+   * @brief Construct a game from a shuffled deck and deal the Klondike piles.
+   * @param dealNumber Deal number of the shuffle, see shuffledDeck.
+   * @param hardMode Whether three cards are drawn from the deck at a time.
+   */
+  explicit GameState(uint64_t dealNumber = 0, bool hardMode = false);
+
+  /**
+   * @brief Get a pile by index.
+   * @param index Index of the pile, between 0 and pileAm - 1.
+   * @return Reference to the pile.
+   */
+  const PileState& getPile(int index) const { return board_.piles[index]; }
+
+  /**
+   * @brief Get the current position.
+   * @return Reference to the board.
+   */
+  const Board& getBoard() const { return board_; }
+
+  /**
+   * @brief Retrieves the deck.
+   * @return Reference to the deck.
+   */
+  const PileState& getDeck() const { return board_.piles[deckIndex]; }
+
+  /**
+   * @brief Retrieves the waste pile.
+   * @return Reference to the waste pile.
+   */
+  const PileState& getWPile() const { return board_.piles[wasteIndex]; }
+
+  /**
+   * @brief Retrieves a Klondike pile.
+   * @param i Index of the Klondike pile, between 0 and KLONDIKE_PILE_AM - 1.
+   * @return Reference to the Klondike pile.
+   */
+  const PileState& getKPile(int i) const {
+    return board_.piles[firstKlondikeIndex + i];
+  }
+
+  /**
+   * @brief Retrieves a target pile.
+   * @param i Index of the target pile, between 0 and TARGET_PILE_AM - 1.
+   * @return Reference to the target pile.
+   */
+  const PileState& getTPile(int i) const {
+    return board_.piles[firstTargetIndex + i];
+  }
+
+  /**
+   * @brief Get player points.
+   * @return points.
+   */
+  unsigned int getPoints() const { return points_; }
+
+  /**
+   * @brief Get the number of moves made.
+   * @return moves.
+   */
+  unsigned int getMoves() const { return moves_; }
+
+  /**
+   * @brief Check whether three cards are drawn from the deck at a time.
+   */
+  bool isHardMode() const { return hardMode_; }
+
+  /**
+   * @brief Set whether three cards are drawn from the deck at a time.
+   */
+  void setHardMode(bool hardMode) { hardMode_ = hardMode; }
+
+  /**
+   * @brief Get the Zobrist hash of the position, see Board::hash.
+   */
+  uint64_t hash() const { return board_.hash(); }
+
+  /**
+   * @brief Get the move history, oldest move first.
+   */
+  const std::vector<StateMove>& getHistory() const { return movehistory_; }
+
+  /**
+   * @brief Get the point change of a move given the current points.
+   * @param move The type of the move.
+   * @return The point change to apply.
+   */
+  int pointChange(MoveType move) const { return ::pointChange(move, points_); }
+
+  /**
+   * @brief Determines the type of move between two piles.
+   * @param fromPile Index of the originating pile.
+   * @param toPile Index of the destination pile.
+   * @return The determined MoveType.
+   */
+  MoveType determineMove(int fromPile, int toPile) const;
+
+  /**
+   * @brief Attempts to move cards between piles and logs the move.
+   *
+   * If the move empties a face-down card in a Klondike pile, the card is
+   * flipped and the flip is logged as well.
+   *
+   * @param fromPile Index of the originating pile.
+   * @param nofCards Number of cards moved from the top of the originating
+   * pile.
+   * @param toPile Index of the destination pile.
+   * @return The number of cards moved, 0 if the move is not legal.
+   */
+  int attemptMove(int fromPile, int nofCards, int toPile);
+
+  /**
+   * @brief Attempts to move cards from the deck to the waste pile, or to
+   * recycle the waste pile when the deck is empty, and logs the move.
+   * @return The number of cards moved, -1 for a recycle and 0 if nothing
+   * happened.
+   */
+  int attemptDeckMove();
+
+  /**
+   * @brief Make a move listed by legalMoves.
+   * @param move The move to make.
+   * @return The number of cards moved, -1 for a recycle and 0 if the move is
+   * not legal.
+   */
+  int applyMove(const BoardMove& move);
+
+  /**
+   * @brief List all legal moves of the current position.
+   * @param moves List the moves are appended to.
+   */
+  void legalMoves(MoveList& moves) const {
+    moveGen_.generate(board_, hardMode_ ? 3 : 1, moves);
+  }
+
+  /**
+   * @brief Undo the last move in history.
+   * @return true if a move was undone, false if the history is empty.
+   */
+  bool undo();
+
+  /**
+   * @brief Checks if the player has won the game.
+   * @return True if all target piles are full, otherwise false.
+   */
+  bool hasWon() const;
+
+ private:
+  Board board_;                         ///< All piles on the table.
+  MoveGenerator moveGen_;               ///< Legal move indices of board_.
+  std::vector<StateMove> movehistory_;  ///< History of moves.
+  unsigned int points_;                 ///< The player's current score.
+  unsigned int moves_;                  ///< Number of moves made.
+  bool hardMode_;  ///< Indicates if the game is in hard mode.
+
+  /**
+   * @brief Add a move to history and apply its points.
+   * @param move The move that was executed.
+   */
+  void logMove(const StateMove& move);
+};
+
+#endif  // GAME_STATE_HPP
@@ -0,0 +1,141 @@
+#include "engine/hintEngine.hpp"
+
+HintEngine::HintEngine()
+    : running_(nullptr), planLength_(defaultPlanLength), stop_(false) {
+  thread_ = std::thread(&HintEngine::run, this);
+}
+
+HintEngine::~HintEngine() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cancel();
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+std::shared_future<HintResult> HintEngine::request(const Board& board,
+                                                   int drawCount,
+                                                   int deadline,
+                                                   Callback onDone,
+                                                   Priority priority) {
+  auto job = std::make_unique<Job>();
+  job->board = board;
+  job->drawCount = drawCount;
+  job->deadline = deadline;
+  job->onDone = std::move(onDone);
+  job->priority = priority;
+  job->planLength = planLength_;
+  std::shared_future<HintResult> future = job->promise.get_future().share();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A request stops the jobs it outranks or equals, the latest one wins
+    if (background_) {
+      drop(*background_);
+      background_.reset();
+    }
+    if (priority == INTERACTIVE && pending_) {
+      drop(*pending_);
+    }
+    if (running_ != nullptr && running_->priority <= priority) {
+      running_->cancelled = true;
+    }
+    (priority == INTERACTIVE ? pending_ : background_) = std::move(job);
+  }
+  cv_.notify_one();
+  return future;
+}
+
+void HintEngine::cancel() {
+  // Taken first, so a job that finished its search is either cancelled here
+  // or has already called onDone, see run
+  std::lock_guard<std::mutex> done(doneMutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (pending_) {
+    drop(*pending_);
+    pending_.reset();
+  }
+  if (background_) {
+    drop(*background_);
+    background_.reset();
+  }
+  if (running_ != nullptr) {
+    running_->cancelled = true;
+  }
+}
+
+void HintEngine::run() {
+  while (true) {
+    std::unique_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return pending_ || background_ || stop_; });
+      if (stop_) {
+        break;
+      }
+      job = std::move(pending_ ? pending_ : background_);
+      running_ = job.get();
+    }
+
+    HintResult result = compute(*job);
+    {
+      // The check and the callback are one step for cancel()
+      std::lock_guard<std::mutex> done(doneMutex_);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = nullptr;
+      }
+      if (!job->cancelled && job->onDone) {
+        job->onDone(result);
+      }
+    }
+    if (job->cancelled) {
+      drop(*job);
+      continue;
+    }
+    job->promise.set_value(std::move(result));
+  }
+}
+
+HintResult HintEngine::compute(const Job& job) {
+  HintResult result;
+  result.hash = job.board.hash();
+  result.drawCount = job.drawCount;
+
+  SolverLimits limits;
+  limits.maxSeconds = job.deadline / 1000.0;
+  limits.cancel = &job.cancelled;
+  SolveResult solved = Solver(job.board, job.drawCount).solve(limits);
+
+  result.outcome = solved.outcome;
+  if (solved.outcome == WINNABLE) {
+    result.moves = std::move(solved.solution);
+  } else if (!solved.bestLine.empty()) {
+    result.moves = std::move(solved.bestLine);
+  } else {
+    // Nothing got further than the position itself, suggest the move the
+    // solver tries first
+    Solver::Frame frame;
+    Solver::expand(Position(job.board, job.drawCount), frame);
+    if (frame.moves.size > 0) {
+      result.moves.push_back(frame.moves.moves[0]);
+    }
+  }
+  if (job.planLength > 0 &&
+      result.moves.size() > static_cast<size_t>(job.planLength)) {
+    result.moves.resize(job.planLength);
+  }
+  return result;
+}
+
+void HintEngine::drop(Job& job) {
+  HintResult result;
+  result.hash = job.board.hash();
+  result.drawCount = job.drawCount;
+  result.cancelled = true;
+  job.promise.set_value(result);
+}
@@ -0,0 +1,149 @@
+#ifndef HINT_ENGINE_HPP
+#define HINT_ENGINE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "engine/solver.hpp"
+
+/**
+ * @brief Answer of the hint engine for one position.
+ */
+struct HintResult {
+  uint64_t hash = 0;             ///< Hash of the position, see Board::hash.
+  int drawCount = 1;             ///< Cards drawn at a time in the search.
+  Outcome outcome = UNDECIDED;   ///< What the search proved about it.
+  std::vector<BoardMove> moves;  ///< Plan of moves, best move first.
+  bool cancelled = false;        ///< Whether the request was cancelled.
+};
+
+/**
+ * @class HintEngine
+ * @brief Computes hints with the solver on a background thread.
+ *
+ * Requests are served one at a time by a single worker thread, so the caller
+ * never blocks. A new request or cancel() stops the search in flight. Each
+ * search has a deadline; when it runs out, the line to the most advanced
+ * position found so far is suggested instead of a winning line.
+ *
+ * Background requests are for hints nobody asked for yet. They wait for, and
+ * never stop, an interactive request.
+ *
+ * A hint is a plan: the first moves of the line, each with its source and
+ * destination pile, so the plan can be followed without searching again.
+ */
+class HintEngine {
+ public:
+  /**
+   * @brief How urgent a request is.
+   */
+  enum Priority {
+    BACKGROUND,   ///< Speculative, served when no interactive request waits.
+    INTERACTIVE,  ///< Asked for by the player.
+  };
+
+  /**
+   * @brief Function called on the worker thread with a finished result.
+   */
+  using Callback = std::function<void(const HintResult&)>;
+
+  static constexpr int defaultPlanLength = 16;  ///< Moves in a plan.
+
+  /**
+   * @brief Construct the engine and start its worker thread.
+   */
+  HintEngine();
+
+  /**
+   * @brief Cancel any request and stop the worker thread.
+   */
+  ~HintEngine();
+
+  /**
+   * @brief Start computing a hint, cancelling the request in flight.
+   * @param board The position to give a hint for.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * @param deadline Time the search may take, in milliseconds.
+   * @param onDone Called on the worker thread when the hint is ready, not
+   * called if the request is cancelled. Must not call cancel().
+   * @param priority Whether the request may stop an interactive one.
+   * @return Future result, with cancelled set if the request is cancelled.
+   */
+  std::shared_future<HintResult> request(const Board& board, int drawCount,
+                                         int deadline,
+                                         Callback onDone = nullptr,
+                                         Priority priority = INTERACTIVE);
+
+  /**
+   * @brief Cancel the request in flight, if any.
+   *
+   * Waits for an onDone call in progress. Once this returns, no callback of
+   * the cancelled requests runs, so the caller can be torn down.
+   */
+  void cancel();
+
+  /**
+   * @brief Set how many moves of the line a hint holds.
+   * @param planLength Number of moves, 0 for the whole line. Applies to the
+   * following requests.
+   */
+  void setPlanLength(int planLength) { planLength_ = planLength; }
+
+  /**
+   * @brief Get how many moves of the line a hint holds.
+   * @return Number of moves, 0 for the whole line.
+   */
+  int getPlanLength() const { return planLength_; }
+
+ private:
+  /**
+   * @brief One hint request.
+   */
+  struct Job {
+    Board board;                       ///< Position to give a hint for.
+    int drawCount;                     ///< Cards drawn at a time.
+    int deadline;                      ///< Search time in milliseconds.
+    Priority priority;                 ///< How urgent the request is.
+    int planLength;                    ///< Moves to keep, 0 for all.
+    Callback onDone;                   ///< Called when the hint is ready.
+    std::promise<HintResult> promise;  ///< Fulfilled when the job ends.
+    std::atomic<bool> cancelled{false};  ///< Stops the search when set.
+  };
+
+  std::mutex doneMutex_;             ///< Held while finishing a job.
+  std::mutex mutex_;                 ///< Guards the members below.
+  std::condition_variable cv_;       ///< Wakes the worker thread.
+  std::unique_ptr<Job> pending_;     ///< Interactive job waiting.
+  std::unique_ptr<Job> background_;  ///< Background job waiting.
+  Job* running_;                     ///< Job being searched, or nullptr.
+  int planLength_;                   ///< Moves in a plan, 0 for all.
+  bool stop_;                        ///< Set to end the worker thread.
+  std::thread thread_;               ///< The worker thread.
+
+  /**
+   * @brief Main loop of the worker thread.
+   */
+  void run();
+
+  /**
+   * @brief Search a position for a hint.
+   * @param job The request.
+   * @return The hint.
+   */
+  static HintResult compute(const Job& job);
+
+  /**
+   * @brief Give a cancelled result to a job that will not be searched.
+   * @param job The job to drop.
+   */
+  static void drop(Job& job);
+};
+
+#endif  // HINT_ENGINE_HPP
@@ -0,0 +1,139 @@
+#include "engine/moveGenerator.hpp"
+
+#include <algorithm>
+
+#include "engine/moveTables.hpp"
+
+MoveGenerator::MoveGenerator()
+    : klondikeTops_(0), targetTops_(0), emptyPiles_(0) {
+  std::fill(std::begin(topCard_), std::end(topCard_), noPile);
+  std::fill(std::begin(pileOfTop_), std::end(pileOfTop_), noPile);
+  std::fill(std::begin(firstFaceUp_), std::end(firstFaceUp_), 0);
+}
+
+void MoveGenerator::reset(const Board& board) {
+  *this = MoveGenerator();
+  for (int pile = 0; pile < Board::pileAm; pile++) {
+    update(board, pile);
+  }
+}
+
+void MoveGenerator::update(const Board& board, int pile) {
+  // Forget the old top card, unless it already became the top of another pile
+  const int oldTop = topCard_[pile];
+  if (oldTop != noPile && pileOfTop_[oldTop] == pile) {
+    pileOfTop_[oldTop] = noPile;
+    klondikeTops_ &= ~cardBit(oldTop);
+    targetTops_ &= ~cardBit(oldTop);
+  }
+  topCard_[pile] = noPile;
+
+  const PileState& state = board.piles[pile];
+  if (state.isEmpty()) {
+    emptyPiles_ |= 1u << pile;
+  } else {
+    emptyPiles_ &= ~(1u << pile);
+  }
+
+  const CardState* top = state.getTopCard();
+  if (top != nullptr && top->isFaceUp()) {
+    const int card = top->getIndex();
+    topCard_[pile] = card;
+    pileOfTop_[card] = pile;
+    klondikeTops_ &= ~cardBit(card);
+    targetTops_ &= ~cardBit(card);
+    if (Board::isKlondike(pile)) klondikeTops_ |= cardBit(card);
+    if (Board::isTarget(pile)) targetTops_ |= cardBit(card);
+  }
+
+  if (Board::isKlondike(pile)) {
+    size_t i = state.getSize();
+    while (i > 0 && state.getCard(i - 1).isFaceUp()) i--;
+    firstFaceUp_[pile] = i;
+  }
+}
+
+int MoveGenerator::firstEmpty(int first, int last) const {
+  const uint32_t range = ((1u << last) - 1) & ~((1u << first) - 1);
+  const uint32_t empty = emptyPiles_ & range;
+  return empty ? lowestCard(empty) : -1;
+}
+
+void MoveGenerator::addCardMoves(int card, int fromPile, int nofCards,
+                                 bool toTarget, bool toEmpty,
+                                 MoveList& moves) const {
+  // Klondike piles whose top card accepts this card
+  uint64_t parents = moveTables.stackParents[card] & klondikeTops_;
+  while (parents) {
+    const int parent = lowestCard(parents);
+    parents &= parents - 1;
+    const int toPile = pileOfTop_[parent];
+    if (toPile != fromPile) {
+      moves.add({Board::moveType(fromPile, toPile),
+                 static_cast<int8_t>(fromPile), static_cast<int8_t>(toPile),
+                 static_cast<int8_t>(nofCards)});
+    }
+  }
+  if (toEmpty && indexRank(card) == KING) {
+    const int toPile =
+        firstEmpty(Board::firstKlondikeIndex, Board::firstTargetIndex);
+    if (toPile >= 0) {
+      moves.add({Board::moveType(fromPile, toPile),
+                 static_cast<int8_t>(fromPile), static_cast<int8_t>(toPile),
+                 static_cast<int8_t>(nofCards)});
+    }
+  }
+
+  if (toTarget) {
+    int toPile = -1;
+    const uint64_t tops = moveTables.followParents[card] & targetTops_;
+    if (tops) {
+      toPile = pileOfTop_[lowestCard(tops)];
+    } else if (indexRank(card) == ACE) {
+      toPile = firstEmpty(Board::firstTargetIndex, Board::pileAm);
+    }
+    if (toPile >= 0) {
+      moves.add({Board::moveType(fromPile, toPile),
+                 static_cast<int8_t>(fromPile), static_cast<int8_t>(toPile),
+                 1});
+    }
+  }
+}
+
+void MoveGenerator::generate(const Board& board, int drawCount,
+                             MoveList& moves) const {
+  // Klondike to Target / Klondike
+  for (int pile = Board::firstKlondikeIndex; pile < Board::firstTargetIndex;
+       pile++) {
+    const PileState& state = board.piles[pile];
+    const int size = state.getSize();
+    for (int i = firstFaceUp_[pile]; i < size; i++) {
+      const int nofCards = size - i;
+      addCardMoves(state.getCard(i).getIndex(), pile, nofCards, nofCards == 1,
+                   i > 0, moves);
+    }
+  }
+
+  // Waste to Target / Klondike
+  const int wasteTop = topCard_[Board::wasteIndex];
+  if (wasteTop != noPile) {
+    addCardMoves(wasteTop, Board::wasteIndex, 1, true, true, moves);
+  }
+
+  // Target to Klondike
+  for (int pile = Board::firstTargetIndex; pile < Board::pileAm; pile++) {
+    if (topCard_[pile] != noPile) {
+      addCardMoves(topCard_[pile], pile, 1, false, true, moves);
+    }
+  }
+
+  // Draw from the deck, or recycle the waste pile
+  const PileState& deck = board.piles[Board::deckIndex];
+  if (!deck.isEmpty()) {
+    const int nofCards = std::min<int>(drawCount, deck.getSize());
+    moves.add({DECK_TO_WASTE, Board::deckIndex, Board::wasteIndex,
+               static_cast<int8_t>(nofCards)});
+  } else if (!board.piles[Board::wasteIndex].isEmpty()) {
+    moves.add({RECYCLE_DECK, Board::wasteIndex, Board::deckIndex, 0});
+  }
+}
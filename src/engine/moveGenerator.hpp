@@ -0,0 +1,119 @@
+#ifndef MOVE_GENERATOR_HPP
+#define MOVE_GENERATOR_HPP
+
+#include <cstdint>
+
+#include "engine/board.hpp"
+
+/**
+ * @brief A legal move on a Board, with piles referred to by index.
+ *
+ * Deck draws go from the deck to the waste pile and move up to three cards.
+ * Recycles go from the waste pile to the deck and have nofCards_ 0.
+ */
+struct BoardMove {
+  MoveType type_;    ///< The type of the move.
+  int8_t fromPile_;  ///< Index of the pile from which the move originates.
+  int8_t toPile_;    ///< Index of the pile to which the move is made.
+  int8_t nofCards_;  ///< Number of cards involved in the move.
+
+  bool operator==(const BoardMove& other) const {
+    return type_ == other.type_ && fromPile_ == other.fromPile_ &&
+           toPile_ == other.toPile_ && nofCards_ == other.nofCards_;
+  }
+};
+
+/**
+ * @brief Fixed-capacity list of moves, filled without allocating.
+ */
+struct MoveList {
+  static constexpr int capacity = 256;  ///< Upper bound of legal moves.
+
+  BoardMove moves[capacity];  ///< The moves, valid up to size.
+  int size = 0;               ///< Number of moves in the list.
+
+  void add(const BoardMove& move) { moves[size++] = move; }
+  const BoardMove* begin() const { return moves; }
+  const BoardMove* end() const { return moves + size; }
+  bool empty() const { return size == 0; }
+};
+
+/**
+ * @class MoveGenerator
+ * @brief Lists every legal move of a Board.
+ *
+ * The generator keeps indices of the top card of each pile and of the face-up
+ * runs in the Klondike piles. They are refreshed pile by pile with update()
+ * as moves are made and undone, so listing moves never rescans the board.
+ *
+ * Moves onto an empty pile are listed once, to the first empty pile of that
+ * kind, and a king already at the bottom of a Klondike pile is not offered to
+ * another empty Klondike pile.
+ */
+class MoveGenerator {
+ public:
+  /**
+   * @brief Construct a generator for an empty board.
+   */
+  MoveGenerator();
+
+  /**
+   * @brief Rebuild all indices from a board.
+   * @param board The board the indices describe.
+   */
+  void reset(const Board& board);
+
+  /**
+   * @brief Refresh the indices of one pile after it changed.
+   * @param board The board the indices describe.
+   * @param pile Index of the pile that changed.
+   */
+  void update(const Board& board, int pile);
+
+  /**
+   * @brief List all legal moves.
+   * @param board The board the indices describe.
+   * @param drawCount Number of cards drawn from the deck at a time.
+   * @param moves List the moves are appended to.
+   */
+  void generate(const Board& board, int drawCount, MoveList& moves) const;
+
+  /**
+   * @brief Get the index of the first face-up card in a Klondike pile.
+   * @param pile Index of a Klondike pile.
+   * @return Index from the bottom, equal to the size if the pile is empty.
+   */
+  int getFirstFaceUp(int pile) const { return firstFaceUp_[pile]; }
+
+ private:
+  static constexpr int8_t noPile = -1;  ///< Marks a card that is not on top.
+
+  int8_t topCard_[Board::pileAm];       ///< Face-up top card per pile, or -1.
+  int8_t pileOfTop_[DECK_SIZE];         ///< Pile of each face-up top card.
+  uint8_t firstFaceUp_[Board::pileAm];  ///< Start of the face-up run.
+  uint64_t klondikeTops_;  ///< Mask of the top cards of Klondike piles.
+  uint64_t targetTops_;    ///< Mask of the top cards of target piles.
+  uint32_t emptyPiles_;    ///< Mask of the empty piles, by pile index.
+
+  /**
+   * @brief Add moves of one card onto Klondike and target piles.
+   * @param card Index of the card moved.
+   * @param fromPile Index of the pile the card is moved from.
+   * @param nofCards Number of cards moved along with it.
+   * @param toTarget Whether the card may go to a target pile.
+   * @param toEmpty Whether a king may go to an empty Klondike pile.
+   * @param moves List the moves are appended to.
+   */
+  void addCardMoves(int card, int fromPile, int nofCards, bool toTarget,
+                    bool toEmpty, MoveList& moves) const;
+
+  /**
+   * @brief Find the first empty pile in a range of pile indices.
+   * @param first First pile index of the range.
+   * @param last One past the last pile index of the range.
+   * @return The index of the pile, or -1 if none is empty.
+   */
+  int firstEmpty(int first, int last) const;
+};
+
+#endif  // MOVE_GENERATOR_HPP
@@ -0,0 +1,139 @@
+#ifndef MOVE_TABLES_HPP
+#define MOVE_TABLES_HPP
+
+#include <cstdint>
+
+#include "engine/cardTypes.hpp"
+
+/**
+ * @brief Precomputed move legality between every pair of cards.
+ *
+ * Cards are referred to by their index (see cardIndex). Built at compile time
+ * so rule checks become a table lookup or a mask AND instead of comparing
+ * colors and ranks on every call.
+ */
+struct MoveTables {
+  /// canStack[card][parent]: card may be placed on parent in a Klondike pile.
+  bool canStack[52][52];
+  /// canFollow[card][top]: card may be placed on top in a target pile.
+  bool canFollow[52][52];
+  /// Bitmask of the cards a card may be placed on in a Klondike pile.
+  uint64_t stackParents[52];
+  /// Bitmask of the cards a card may be placed on in a target pile.
+  uint64_t followParents[52];
+  /// Bitmask of the cards that may be placed on a card in a Klondike pile.
+  uint64_t stackChildren[52];
+};
+
+/**
+ * @brief Get the bit of a card in a 52 bit card mask.
+ * @param index Card index, see cardIndex.
+ */
+constexpr uint64_t cardBit(int index) { return uint64_t(1) << index; }
+
+/**
+ * @brief Get the index of the lowest card in a non-empty card mask.
+ * @param mask Card mask, must not be 0.
+ */
+inline int lowestCard(uint64_t mask) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(mask);
+#else
+  int index = 0;
+  while (!(mask & 1)) {
+    mask >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+/**
+ * @brief Get the number of cards in a card mask.
+ * @param mask Card mask.
+ */
+inline int cardCount(uint64_t mask) {
+#if defined(__GNUC__)
+  return __builtin_popcountll(mask);
+#else
+  int count = 0;
+  for (; mask != 0; mask &= mask - 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+/**
+ * @brief Build the move tables, evaluated at compile time.
+ */
+constexpr MoveTables makeMoveTables() {
+  MoveTables tables{};
+  for (int card = 0; card < 52; card++) {
+    const Suit suit = indexSuit(card);
+    const Rank rank = indexRank(card);
+    for (int other = 0; other < 52; other++) {
+      const Suit otherSuit = indexSuit(other);
+      const Rank otherRank = indexRank(other);
+      const bool stack =
+          suitColor(suit) != suitColor(otherSuit) && rank == otherRank - 1;
+      const bool follow = suit == otherSuit && rank == otherRank + 1;
+      tables.canStack[card][other] = stack;
+      tables.canFollow[card][other] = follow;
+      if (stack) {
+        tables.stackParents[card] |= cardBit(other);
+        tables.stackChildren[other] |= cardBit(card);
+      }
+      if (follow) tables.followParents[card] |= cardBit(other);
+    }
+  }
+  return tables;
+}
+
+/**
+ * @brief The move tables shared by the GUI piles and the rules engine.
+ */
+inline constexpr MoveTables moveTables = makeMoveTables();
+
+/// Bitmask of the four aces, the only cards accepted by an empty target pile.
+inline constexpr uint64_t aceMask = cardBit(cardIndex(CLUBS, ACE)) |
+                                    cardBit(cardIndex(DIAMONDS, ACE)) |
+                                    cardBit(cardIndex(SPADES, ACE)) |
+                                    cardBit(cardIndex(HEARTS, ACE));
+
+/// Bitmask of the four kings, the only cards accepted by an empty Klondike
+/// pile.
+inline constexpr uint64_t kingMask = cardBit(cardIndex(CLUBS, KING)) |
+                                     cardBit(cardIndex(DIAMONDS, KING)) |
+                                     cardBit(cardIndex(SPADES, KING)) |
+                                     cardBit(cardIndex(HEARTS, KING));
+
+/**
+ * @brief Check whether a card may be placed on another in a Klondike pile.
+ * @param card Index of the card being moved.
+ * @param parent Index of the top card of the Klondike pile.
+ */
+constexpr bool canStackOnKlondike(int card, int parent) {
+  return moveTables.canStack[card][parent];
+}
+
+/**
+ * @brief Check whether a card may be placed on another in a target pile.
+ * @param card Index of the card being moved.
+ * @param top Index of the top card of the target pile.
+ */
+constexpr bool canFollowOnTarget(int card, int top) {
+  return moveTables.canFollow[card][top];
+}
+
+static_assert(canStackOnKlondike(cardIndex(HEARTS, QUEEN),
+                                 cardIndex(SPADES, KING)),
+              "Red queen goes on black king");
+static_assert(!canStackOnKlondike(cardIndex(CLUBS, QUEEN),
+                                  cardIndex(SPADES, KING)),
+              "Same color does not stack");
+static_assert(canFollowOnTarget(cardIndex(HEARTS, TWO),
+                                cardIndex(HEARTS, ACE)),
+              "Two follows ace of the same suit");
+
+#endif  // MOVE_TABLES_HPP
@@ -0,0 +1,258 @@
+#include "engine/parallelSolver.hpp"
+
+#include <algorithm>
+#include <thread>
+
+ParallelSolver::ParallelSolver(const Board& board, int drawCount, int threads,
+                               size_t tableSize)
+    : root_(board, drawCount),
+      threadCount_(threads),
+      seen_(tableSize),
+      idle_(0),
+      queued_(0),
+      pending_(0),
+      stop_(false),
+      aborted_(false),
+      nodes_(0) {
+  if (threadCount_ <= 0) {
+    threadCount_ = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (int i = 0; i < threadCount_; i++) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+}
+
+ParallelSolver::ParallelSolver(const GameState& state, int threads,
+                               size_t tableSize)
+    : ParallelSolver(state.getBoard(), state.isHardMode() ? 3 : 1, threads,
+                     tableSize) {}
+
+SolveResult ParallelSolver::solve(const SolverLimits& limits) {
+  start_ = std::chrono::steady_clock::now();
+  seen_.clear();
+  for (auto& worker : workers_) {
+    worker->tasks.clear();
+    worker->stats = WorkerStats();
+  }
+  idle_ = 0;
+  queued_ = 1;
+  pending_ = 1;
+  stop_ = false;
+  aborted_ = false;
+  nodes_ = 0;
+  solution_.clear();
+
+  SolveResult result;
+  if (root_.isWon()) {
+    result.outcome = WINNABLE;
+    return result;
+  }
+  seen_.insert(root_.canonicalHash());
+  workers_[0]->tasks.emplace_back();
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < threadCount_; i++) {
+    threads.emplace_back(&ParallelSolver::work, this, i, std::cref(limits));
+  }
+  work(0, limits);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  if (!solution_.empty()) {
+    result.outcome = WINNABLE;
+    result.solution = solution_;
+  } else if (!aborted_ && !seen_.isFull()) {
+    result.outcome = UNWINNABLE;
+  }
+  for (auto& worker : workers_) {
+    result.nodes += worker->stats.nodes;
+    result.workers.push_back(worker->stats);
+  }
+  result.seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start_)
+                       .count();
+  return result;
+}
+
+void ParallelSolver::work(int id, const SolverLimits& limits) {
+  const auto start = std::chrono::steady_clock::now();
+  Task task;
+  while (takeTask(id, task)) {
+    search(id, task, limits);
+    finishTask();
+  }
+  workers_[id]->stats.seconds = std::chrono::duration<double>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count();
+}
+
+bool ParallelSolver::takeTask(int id, Task& task) {
+  while (!stop_) {
+    // Own queue newest first, to stay deep in the tree
+    {
+      Worker& own = *workers_[id];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.tasks.empty()) {
+        task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        queued_--;
+        return true;
+      }
+    }
+    // Other queues oldest first, as the oldest tasks are the largest
+    for (int i = 1; i < threadCount_; i++) {
+      Worker& victim = *workers_[(id + i) % threadCount_];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued_--;
+        workers_[id]->stats.steals++;
+        return true;
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(idleMutex_);
+    idle_++;
+    idleCv_.wait(lock, [this]() { return stop_ || queued_ > 0; });
+    idle_--;
+  }
+  return false;
+}
+
+void ParallelSolver::search(int id, const Task& task,
+                            const SolverLimits& limits) {
+  WorkerStats& stats = workers_[id]->stats;
+  Position position = root_;
+  for (const BoardMove& move : task) {
+    position.makeMove(move);
+  }
+  // Tasks other than the root start with a move nobody has checked yet
+  if (!task.empty()) {
+    if (position.isWon()) {
+      std::lock_guard<std::mutex> lock(solutionMutex_);
+      if (solution_.empty()) solution_ = task;
+      stop();
+      return;
+    }
+    if (!seen_.insert(position.canonicalHash())) {
+      return;
+    }
+  }
+
+  std::vector<Solver::Frame> stack(64);
+  size_t depth = 0;
+  Solver::expand(position, stack[depth++]);
+  stats.nodes++;
+  uint64_t batch = 1;
+
+  while (depth > 0) {
+    Solver::Frame& frame = stack[depth - 1];
+    if (frame.next == frame.moves.size) {
+      if (--depth > 0) {
+        const Solver::Frame& parent = stack[depth - 1];
+        position.unmakeMove(parent.moves.moves[parent.next - 1], parent.undo);
+      }
+      continue;
+    }
+
+    const BoardMove& move = frame.moves.moves[frame.next++];
+    frame.undo = position.makeMove(move);
+    if (position.isWon()) {
+      std::lock_guard<std::mutex> lock(solutionMutex_);
+      if (solution_.empty()) {
+        solution_ = task;
+        for (size_t i = 0; i < depth; i++) {
+          solution_.push_back(stack[i].moves.moves[stack[i].next - 1]);
+        }
+      }
+      stop();
+      return;
+    }
+    if (!seen_.insert(position.canonicalHash())) {
+      if (seen_.isFull()) {
+        stop();
+        return;
+      }
+      position.unmakeMove(move, frame.undo);
+      continue;
+    }
+
+    stats.nodes++;
+    if ((++batch & 255) == 0) {
+      if (stop_.load(std::memory_order_relaxed)) {
+        return;
+      }
+      if ((batch & 1023) == 0) {
+        const uint64_t nodes = nodes_.fetch_add(1024) + 1024;
+        const double seconds = std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() - start_)
+                                   .count();
+        if ((limits.maxNodes > 0 && nodes >= limits.maxNodes) ||
+            (limits.maxSeconds > 0 && seconds >= limits.maxSeconds) ||
+            (limits.cancel != nullptr && limits.cancel->load())) {
+          aborted_ = true;
+          stop();
+          return;
+        }
+      }
+      if (idle_.load(std::memory_order_relaxed) > 0) {
+        split(id, task, stack, depth);
+      }
+    }
+
+    if (depth == stack.size()) {
+      stack.resize(stack.size() * 2);
+    }
+    Solver::expand(position, stack[depth++]);
+  }
+}
+
+void ParallelSolver::split(int id, const Task& task,
+                           std::vector<Solver::Frame>& stack, size_t depth) {
+  for (size_t i = 0; i < depth; i++) {
+    Solver::Frame& frame = stack[i];
+    if (frame.next == frame.moves.size) {
+      continue;
+    }
+
+    Task prefix = task;
+    for (size_t j = 0; j < i; j++) {
+      prefix.push_back(stack[j].moves.moves[stack[j].next - 1]);
+    }
+    const int nofTasks = frame.moves.size - frame.next;
+    pending_ += nofTasks;
+    queued_ += nofTasks;
+    {
+      // Best move last, where this thread takes its next task from
+      Worker& own = *workers_[id];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      for (int j = frame.moves.size - 1; j >= frame.next; j--) {
+        own.tasks.push_back(prefix);
+        own.tasks.back().push_back(frame.moves.moves[j]);
+      }
+    }
+    // Drop the moves rather than skip them, next - 1 is still being searched
+    frame.moves.size = frame.next;
+    {
+      std::lock_guard<std::mutex> lock(idleMutex_);
+    }
+    idleCv_.notify_all();
+    return;
+  }
+}
+
+void ParallelSolver::finishTask() {
+  if (--pending_ == 0) {
+    stop();
+  }
+}
+
+void ParallelSolver::stop() {
+  stop_ = true;
+  {
+    std::lock_guard<std::mutex> lock(idleMutex_);
+  }
+  idleCv_.notify_all();
+}
@@ -0,0 +1,140 @@
+#ifndef PARALLEL_SOLVER_HPP
+#define PARALLEL_SOLVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "engine/solver.hpp"
+
+/**
+ * @class ParallelSolver
+ * @brief Solver that splits the search tree across threads.
+ *
+ * Every thread runs the same depth-first search as Solver on its own part of
+ * the tree, and all of them share one ConcurrentTranspositionTable, so no
+ * position is expanded twice. Work is balanced by work stealing: when some
+ * thread is idle, busy threads hand the untried moves of their shallowest
+ * frame to their own task queue, and idle threads take the oldest task of
+ * another thread's queue.
+ *
+ * A task is the move sequence from the root to the position it starts from,
+ * so a thread replays it on a copy of the root instead of sharing positions.
+ */
+class ParallelSolver {
+ public:
+  /**
+   * @brief Construct a solver for a position.
+   * @param board The piles on the table.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * @param threads Number of search threads, 0 for one per hardware thread.
+   * @param tableSize Number of transposition table slots. The search is
+   * UNDECIDED if three quarters of them fill up.
+   */
+  ParallelSolver(const Board& board, int drawCount, int threads = 0,
+                 size_t tableSize = 1 << 22);
+
+  /**
+   * @brief Construct a solver for the current position of a game.
+   * @param state The game, drawing three cards at a time in hard mode.
+   * @param threads Number of search threads, 0 for one per hardware thread.
+   * @param tableSize Number of transposition table slots.
+   */
+  explicit ParallelSolver(const GameState& state, int threads = 0,
+                          size_t tableSize = 1 << 22);
+
+  /**
+   * @brief Get the number of search threads.
+   */
+  int getThreadCount() const { return threadCount_; }
+
+  /**
+   * @brief Search for a winning move sequence with all threads.
+   * @param limits Bounds on the search, nodes counted over all threads.
+   * @return The outcome, the winning moves and statistics per thread.
+   */
+  SolveResult solve(const SolverLimits& limits = SolverLimits());
+
+ private:
+  /**
+   * @brief Part of the tree to search: the moves leading to it from the root.
+   */
+  using Task = std::vector<BoardMove>;
+
+  /**
+   * @brief Task queue and statistics of one thread.
+   */
+  struct Worker {
+    std::mutex mutex;         ///< Guards tasks.
+    std::deque<Task> tasks;   ///< Tasks split off by this thread.
+    WorkerStats stats;        ///< Written by the owning thread only.
+  };
+
+  Position root_;                       ///< Position the search starts from.
+  int threadCount_;                     ///< Number of search threads.
+  ConcurrentTranspositionTable seen_;   ///< Canonical hashes of positions.
+  std::vector<std::unique_ptr<Worker>> workers_;  ///< One per thread.
+
+  std::mutex idleMutex_;             ///< Guards waiting for tasks.
+  std::condition_variable idleCv_;   ///< Wakes threads waiting for tasks.
+  std::atomic<int> idle_;            ///< Threads waiting for a task.
+  std::atomic<int> queued_;          ///< Tasks in all queues.
+  std::atomic<int> pending_;         ///< Tasks queued or being searched.
+  std::atomic<bool> stop_;           ///< Set when the search must end.
+  std::atomic<bool> aborted_;        ///< Set when a limit was hit.
+  std::atomic<uint64_t> nodes_;      ///< Nodes expanded, in batches.
+  std::chrono::steady_clock::time_point start_;  ///< Start of the search.
+
+  std::mutex solutionMutex_;         ///< Guards solution_.
+  std::vector<BoardMove> solution_;  ///< First winning line found.
+
+  /**
+   * @brief Main loop of a search thread.
+   * @param id Index of the thread.
+   * @param limits Bounds on the search.
+   */
+  void work(int id, const SolverLimits& limits);
+
+  /**
+   * @brief Take a task, waiting until one is queued or the search ends.
+   * @param id Index of the thread, whose own queue is tried first.
+   * @param task Set to the task taken.
+   * @return False when the search has ended.
+   */
+  bool takeTask(int id, Task& task);
+
+  /**
+   * @brief Search the subtree of a task depth-first.
+   * @param id Index of the thread.
+   * @param task The task to search.
+   * @param limits Bounds on the search.
+   */
+  void search(int id, const Task& task, const SolverLimits& limits);
+
+  /**
+   * @brief Queue the untried moves of the shallowest frame that has any.
+   * @param id Index of the thread.
+   * @param task The task being searched.
+   * @param stack The frames of the search.
+   * @param depth Number of frames in use.
+   */
+  void split(int id, const Task& task, std::vector<Solver::Frame>& stack,
+             size_t depth);
+
+  /**
+   * @brief Mark a task as done and end the search when none are left.
+   */
+  void finishTask();
+
+  /**
+   * @brief End the search and wake all waiting threads.
+   */
+  void stop();
+};
+
+#endif  // PARALLEL_SOLVER_HPP
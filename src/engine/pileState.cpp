@@ -0,0 +1,67 @@
+#include "engine/pileState.hpp"
+
+#include <cstring>
+
+#include "engine/moveTables.hpp"
+
+const CardState* PileState::getTopCard() const {
+  if (!this->isEmpty()) {
+    return &cards_[size_ - 1];
+  }
+  return nullptr;
+}
+
+const CardState* PileState::getCardFromBack(const size_t i) const {
+  if (i < size_) {
+    return &cards_[size_ - 1 - i];
+  }
+  return nullptr;
+}
+
+bool PileState::isValid(const CardState& card) const {
+  if (!card.isFaceUp()) {
+    return false;
+  }
+  const CardState* top = getTopCard();
+  switch (kind_) {
+    case KLONDIKE_PILE:
+      if (top == nullptr) {
+        return card.getRank() == Rank::KING;
+      }
+      return canStackOnKlondike(card.getIndex(), top->getIndex());
+    case TARGET_PILE:
+      if (top == nullptr) {
+        return card.getRank() == Rank::ACE;
+      }
+      return canFollowOnTarget(card.getIndex(), top->getIndex());
+    default:
+      return false;
+  }
+}
+
+void PileState::transferCards(PileState& other, const unsigned int nof) {
+  if (!this->isEmpty() && nof <= this->getSize()) {
+    size_ -= nof;
+    for (unsigned int i = 0; i < nof; i++) {
+      const CardState& card = cards_[size_ + i];
+      hash_ ^= zobristKey(kind_, size_ + i, card);
+      other.hash_ ^= zobristKey(other.kind_, other.size_ + i, card);
+    }
+    std::memcpy(other.cards_ + other.size_, cards_ + size_, nof);
+    other.size_ += nof;
+  }
+}
+
+bool PileState::flipTopCard(bool faceUp) {
+  if (this->isEmpty()) {
+    return false;  // No cards to flip
+  }
+  CardState& card = cards_[size_ - 1];
+  if (card.isFaceUp() != faceUp) {
+    hash_ ^= zobristKey(kind_, size_ - 1, card);
+    card.flip();
+    hash_ ^= zobristKey(kind_, size_ - 1, card);
+    return faceUp;
+  }
+  return false;  // No action taken
+}
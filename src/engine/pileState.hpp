@@ -0,0 +1,135 @@
+#ifndef PILE_STATE_HPP
+#define PILE_STATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "engine/cardState.hpp"
+#include "engine/zobrist.hpp"
+
+/**
+ * @brief The role a pile plays on the table, which decides its rules.
+ */
+enum PileKind { DECK_PILE, WASTE_PILE, KLONDIKE_PILE, TARGET_PILE };
+
+/**
+ * @class PileState
+ * @brief Qt-free pile of cards following the rules of Deck, WastePile,
+ * KlondikePile or TargetPile depending on its kind.
+ *
+ * Cards are stored inline in a fixed array sized for a whole deck, so a pile
+ * never allocates and can be copied with memcpy. The pile keeps the Zobrist
+ * hash of its cards, updated as cards are added, moved and flipped.
+ */
+class PileState {
+ public:
+  /**
+   * @brief Construct an empty pile.
+   * @param kind The role of the pile, which decides what it accepts.
+   * @param index Index of the pile on the table.
+   */
+  explicit PileState(PileKind kind = DECK_PILE, int index = 0)
+      : hash_(0),
+        size_(0),
+        kind_(static_cast<uint8_t>(kind)),
+        index_(static_cast<uint8_t>(index)) {}
+
+  /**
+   * @brief Get the role of the pile.
+   * @return The kind of the pile.
+   */
+  PileKind getKind() const { return static_cast<PileKind>(kind_); }
+
+  /**
+   * @brief Get the index of the pile on the table.
+   */
+  int getIndex() const { return index_; }
+
+  /**
+   * @brief Get the Zobrist hash of the cards in the pile.
+   *
+   * Cards are keyed by the kind of the pile, not its place, so piles of the
+   * same kind holding the same cards have the same hash. Board::hash tells
+   * the places apart.
+   *
+   * @return XOR of the zobristKey of every card, 0 if the pile is empty.
+   */
+  uint64_t getHash() const { return hash_; }
+
+  /**
+   * @brief Get the number of cards in the pile.
+   * @return The number of cards in the pile.
+   */
+  size_t getSize() const { return size_; }
+
+  /**
+   * @brief Check whether the pile is empty.
+   * @return true if the pile is empty, false otherwise.
+   */
+  bool isEmpty() const { return size_ == 0; }
+
+  /**
+   * @brief Get the card that is on top of the pile.
+   * @return Pointer to the top card, or nullptr if the pile is empty.
+   */
+  const CardState* getTopCard() const;
+
+  /**
+   * @brief Get a card from the back of the pile by index.
+   * @param i The index of the card from the back (0 is the top card).
+   * @return Pointer to the specified card, or nullptr if out of range.
+   */
+  const CardState* getCardFromBack(const size_t i) const;
+
+  /**
+   * @brief Check if a card can be added to the pile.
+   * @param card The card to check.
+   * @return true if the card can be added, false otherwise.
+   *
+   * Decks and waste piles never accept cards directly. Klondike piles accept a
+   * face-up KING when empty, otherwise a face-up card of opposite color and one
+   * rank lower. Target piles accept a face-up ACE when empty, otherwise the
+   * face-up card of the same suit and one rank higher.
+   */
+  bool isValid(const CardState& card) const;
+
+  /**
+   * @brief Add a card on top of the pile.
+   * @param card The card to add.
+   */
+  void addCard(const CardState& card) {
+    hash_ ^= zobristKey(kind_, size_, card);
+    cards_[size_++] = card;
+  }
+
+  /**
+   * @brief Get a card from the bottom of the pile by index.
+   * @param i The index of the card from the bottom (0 is the bottom card).
+   * @return The card. The index must be less than getSize().
+   */
+  CardState getCard(const size_t i) const { return cards_[i]; }
+
+  /**
+   * @brief Move one or more cards from this pile to another pile, keeping
+   * their order.
+   * @param other Reference to the target pile.
+   * @param nof Number of cards to transfer (default is 1).
+   */
+  void transferCards(PileState& other, const unsigned int nof = 1);
+
+  /**
+   * @brief Flip the top card up/down.
+   * @param faceUp True for flip up, false for down.
+   * @return true when a face-down card was flipped up, false otherwise.
+   */
+  bool flipTopCard(bool faceUp);
+
+ private:
+  uint64_t hash_;               ///< Zobrist hash of the cards.
+  uint8_t size_;                ///< Number of cards in the pile.
+  uint8_t kind_;                ///< The role of the pile, a PileKind.
+  uint8_t index_;               ///< Index of the pile on the table.
+  CardState cards_[DECK_SIZE];  ///< All the cards inside this pile.
+};
+
+#endif  // PILE_STATE_HPP
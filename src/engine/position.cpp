@@ -0,0 +1,79 @@
+#include "engine/position.hpp"
+
+Position::Position(const Board& board, int drawCount)
+    : board_(board), drawCount_(drawCount) {
+  moveGen_.reset(board_);
+}
+
+MoveUndo Position::makeMove(const BoardMove& move) {
+  MoveUndo undo{0, false};
+  PileState& deck = board_.piles[Board::deckIndex];
+  PileState& waste = board_.piles[Board::wasteIndex];
+
+  if (move.type_ == DECK_TO_WASTE) {
+    while (undo.nofCards_ < move.nofCards_ && !deck.isEmpty()) {
+      deck.flipTopCard(true);
+      deck.transferCards(waste);
+      undo.nofCards_++;
+    }
+  } else if (move.type_ == RECYCLE_DECK) {
+    while (!waste.isEmpty()) {
+      waste.flipTopCard(false);
+      waste.transferCards(deck);
+      undo.nofCards_++;
+    }
+  } else {
+    PileState& from = board_.piles[move.fromPile_];
+    from.transferCards(board_.piles[move.toPile_], move.nofCards_);
+    if (Board::isKlondike(move.fromPile_)) {
+      undo.flipped_ = from.flipTopCard(true);
+    }
+  }
+  moveGen_.update(board_, move.fromPile_);
+  moveGen_.update(board_, move.toPile_);
+  return undo;
+}
+
+void Position::unmakeMove(const BoardMove& move, const MoveUndo& undo) {
+  PileState& deck = board_.piles[Board::deckIndex];
+  PileState& waste = board_.piles[Board::wasteIndex];
+
+  if (move.type_ == DECK_TO_WASTE) {
+    for (int i = 0; i < undo.nofCards_; i++) {
+      waste.flipTopCard(false);
+      waste.transferCards(deck);
+    }
+  } else if (move.type_ == RECYCLE_DECK) {
+    for (int i = 0; i < undo.nofCards_; i++) {
+      deck.flipTopCard(true);
+      deck.transferCards(waste);
+    }
+  } else {
+    PileState& from = board_.piles[move.fromPile_];
+    if (undo.flipped_) {
+      from.flipTopCard(false);
+    }
+    board_.piles[move.toPile_].transferCards(from, move.nofCards_);
+  }
+  moveGen_.update(board_, move.fromPile_);
+  moveGen_.update(board_, move.toPile_);
+}
+
+int Position::targetHeight(Suit suit) const {
+  for (int i = Board::firstTargetIndex; i < Board::pileAm; i++) {
+    const CardState* top = board_.piles[i].getTopCard();
+    if (top != nullptr && top->getSuit() == suit) {
+      return top->getRank();
+    }
+  }
+  return 0;
+}
+
+bool Position::isWon() const {
+  for (int i = Board::firstTargetIndex; i < Board::pileAm; i++) {
+    if (board_.piles[i].getSize() != 13) {
+      return false;
+    }
+  }
+  return true;
+}
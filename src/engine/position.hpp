@@ -0,0 +1,100 @@
+#ifndef POSITION_HPP
+#define POSITION_HPP
+
+#include <cstdint>
+
+#include "engine/board.hpp"
+#include "engine/moveGenerator.hpp"
+
+/**
+ * @brief What is needed to take back a move made on a Position.
+ */
+struct MoveUndo {
+  uint8_t nofCards_;  ///< Number of cards moved by a deck draw or recycle.
+  bool flipped_;      ///< Whether a Klondike card was flipped by the move.
+};
+
+/**
+ * @class Position
+ * @brief A Board with its move generator, for fast search and simulation.
+ *
+ * Unlike GameState, a Position keeps no history or score. Moves are made and
+ * taken back with makeMove and unmakeMove, which only touch the piles
+ * involved.
+ */
+class Position {
+ public:
+  /**
+   * @brief Construct a position.
+   * @param board The piles on the table.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   */
+  explicit Position(const Board& board = Board(), int drawCount = 1);
+
+  /**
+   * @brief Get the piles on the table.
+   */
+  const Board& getBoard() const { return board_; }
+
+  /**
+   * @brief Get the number of cards drawn from the deck at a time.
+   */
+  int getDrawCount() const { return drawCount_; }
+
+  /**
+   * @brief Get the move generator of the position.
+   */
+  const MoveGenerator& getMoveGenerator() const { return moveGen_; }
+
+  /**
+   * @brief List all legal moves.
+   * @param moves List the moves are appended to.
+   */
+  void legalMoves(MoveList& moves) const {
+    moveGen_.generate(board_, drawCount_, moves);
+  }
+
+  /**
+   * @brief Make a legal move, flipping the card it uncovers.
+   * @param move A move listed by legalMoves.
+   * @return What is needed to take the move back.
+   */
+  MoveUndo makeMove(const BoardMove& move);
+
+  /**
+   * @brief Take back the last move made.
+   * @param move The move passed to makeMove.
+   * @param undo The value returned by makeMove.
+   */
+  void unmakeMove(const BoardMove& move, const MoveUndo& undo);
+
+  /**
+   * @brief Get the number of cards of a suit on the target piles.
+   * @param suit The suit.
+   * @return Rank of the highest card of the suit on a target pile, 0 if none.
+   */
+  int targetHeight(Suit suit) const;
+
+  /**
+   * @brief Check whether all cards are on the target piles.
+   */
+  bool isWon() const;
+
+  /**
+   * @brief Get the Zobrist hash of the position, see Board::hash.
+   */
+  uint64_t hash() const { return board_.hash(); }
+
+  /**
+   * @brief Get the hash of the position up to the order of its piles, see
+   * Board::canonicalHash.
+   */
+  uint64_t canonicalHash() const { return board_.canonicalHash(); }
+
+ private:
+  Board board_;            ///< The piles on the table.
+  MoveGenerator moveGen_;  ///< Legal move indices of board_.
+  int drawCount_;          ///< Number of cards drawn at a time.
+};
+
+#endif  // POSITION_HPP
@@ -0,0 +1,63 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+
+/**
+ * @brief Scramble a 64-bit value (the SplitMix64 finalizer).
+ * @param x The value to scramble.
+ * @return A well mixed 64-bit value, distinct for distinct inputs.
+ */
+constexpr uint64_t splitMix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/**
+ * @class DealRandom
+ * @brief Small random number generator that gives the same numbers on every
+ * platform and standard library.
+ *
+ * The standard engines are portable, but the distributions and std::shuffle
+ * are not, so deals are drawn with this generator and an explicit
+ * Fisher-Yates shuffle instead. The sequence is that of SplitMix64.
+ */
+class DealRandom {
+ public:
+  /**
+   * @brief Construct a generator.
+   * @param seed Any 64-bit value.
+   */
+  explicit DealRandom(uint64_t seed) : state_(seed) {}
+
+  /**
+   * @brief Get the next 64 random bits.
+   */
+  uint64_t next() {
+    const uint64_t value = splitMix64(state_);
+    state_ += 0x9e3779b97f4a7c15ull;
+    return value;
+  }
+
+  /**
+   * @brief Get a uniformly distributed number below a bound.
+   * @param bound The bound, greater than 0.
+   * @return A number from 0 to bound - 1, without modulo bias.
+   */
+  uint64_t below(uint64_t bound) {
+    // Reject the lowest 2^64 % bound values so the rest divide evenly
+    const uint64_t threshold = (0 - bound) % bound;
+    uint64_t value = next();
+    while (value < threshold) {
+      value = next();
+    }
+    return value % bound;
+  }
+
+ private:
+  uint64_t state_;  ///< Position in the sequence.
+};
+
+#endif  // RANDOM_HPP
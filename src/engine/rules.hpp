@@ -0,0 +1,87 @@
+#ifndef RULES_HPP
+#define RULES_HPP
+
+#include <cstdint>
+
+#define KLONDIKE_PILE_AM 7  ///< Number of Klondike piles in the game.
+#define TARGET_PILE_AM 4    ///< Number of target piles in the game.
+
+/**
+ * @brief Enum representing different types of moves in the game.
+ *
+ * Each move type has an associated point value that impacts the player's score.
+ */
+enum MoveType : uint8_t {
+  WASTE_TO_KLONDIKE,
+  WASTE_TO_TARGET,
+  KLONDIKE_TO_TARGET,
+  KLONDIKE_TO_KLONDIKE,
+  FLIP_KLONDIKE,
+  TARGET_TO_KLONDIKE,
+  DECK_TO_WASTE,
+  RECYCLE_DECK,
+  UNKNOWN
+};
+
+/**
+ * @brief Table of points awarded for each type of move.
+ */
+struct MovePoints {
+  static const int wToKPoints = 5;
+  static const int wToTPoints = 10;
+  static const int kToTPoints = 10;
+  static const int kToKPoints = 0;
+
+  static const int turnOverPoints = 5;
+  static const int tToKPoints = -15;
+  static const int dToWPoints = 0;
+  static const int recycleDeckPoints = -100;
+};
+
+/**
+ * @brief Get the raw point value of a move type.
+ * @param move The type of the move.
+ * @return Points from the MovePoints table, 0 for UNKNOWN.
+ */
+constexpr int rawPointChange(MoveType move) {
+  switch (move) {
+    case (WASTE_TO_KLONDIKE):
+      return MovePoints::wToKPoints;
+    case (WASTE_TO_TARGET):
+      return MovePoints::wToTPoints;
+    case (KLONDIKE_TO_TARGET):
+      return MovePoints::kToTPoints;
+    case (KLONDIKE_TO_KLONDIKE):
+      return MovePoints::kToKPoints;
+    case (FLIP_KLONDIKE):
+      return MovePoints::turnOverPoints;
+    case (TARGET_TO_KLONDIKE):
+      return MovePoints::tToKPoints;
+    case (DECK_TO_WASTE):
+      return MovePoints::dToWPoints;
+    case (RECYCLE_DECK):
+      return MovePoints::recycleDeckPoints;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Get the point change of a move given the player's current points.
+ *
+ * Points cannot go negative, so penalties are capped at the current score.
+ *
+ * @param move The type of the move.
+ * @param points The player's current points.
+ * @return The point change to apply.
+ */
+constexpr int pointChange(MoveType move, unsigned int points) {
+  int rawChange = rawPointChange(move);
+  // Points cannot be negative, also prevent int underflow
+  if (rawChange < 0 && points < static_cast<unsigned int>(-rawChange)) {
+    rawChange = -static_cast<int>(points);
+  }
+  return rawChange;
+}
+
+#endif  // RULES_HPP
@@ -0,0 +1,181 @@
+#include "engine/solver.hpp"
+
+#include <chrono>
+
+#include "engine/foundations.hpp"
+
+Solver::Solver(const Board& board, int drawCount)
+    : root_(board, drawCount) {}
+
+Solver::Solver(const GameState& state)
+    : Solver(state.getBoard(), state.isHardMode() ? 3 : 1) {}
+
+SolveResult Solver::solve(const SolverLimits& limits) {
+  const auto start = std::chrono::steady_clock::now();
+  auto elapsed = [&start]() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                         start)
+        .count();
+  };
+
+  SolveResult result;
+  Position position = root_;
+  seen_.clear();
+  if (position.isWon()) {
+    result.outcome = WINNABLE;
+    return result;
+  }
+
+  // Frames are reused across the search instead of being pushed and popped
+  std::vector<Frame> stack(256);
+  size_t depth = 0;
+  seen_.insert(position.canonicalHash());
+  expand(position, stack[depth++]);
+  result.nodes = 1;
+
+  bool aborted = false;
+  int bestProgress = progress(position);
+  while (depth > 0) {
+    Frame& frame = stack[depth - 1];
+    if (frame.next == frame.moves.size) {
+      // All moves tried, backtrack to the parent position
+      if (--depth > 0) {
+        const Frame& parent = stack[depth - 1];
+        position.unmakeMove(parent.moves.moves[parent.next - 1], parent.undo);
+      }
+      continue;
+    }
+
+    const BoardMove& move = frame.moves.moves[frame.next++];
+    frame.undo = position.makeMove(move);
+    if (position.isWon()) {
+      result.outcome = WINNABLE;
+      result.solution.reserve(depth);
+      for (size_t i = 0; i < depth; i++) {
+        result.solution.push_back(stack[i].moves.moves[stack[i].next - 1]);
+      }
+      break;
+    }
+    if (!seen_.insert(position.canonicalHash())) {
+      position.unmakeMove(move, frame.undo);
+      continue;
+    }
+
+    // Remember the way to the most advanced position, for hints
+    const int positionProgress = progress(position);
+    if (positionProgress > bestProgress) {
+      bestProgress = positionProgress;
+      result.bestLine.clear();
+      for (size_t i = 0; i < depth; i++) {
+        result.bestLine.push_back(stack[i].moves.moves[stack[i].next - 1]);
+      }
+    }
+
+    if ((++result.nodes & 1023) == 0 &&
+        ((limits.maxNodes > 0 && result.nodes >= limits.maxNodes) ||
+         (limits.maxSeconds > 0 && elapsed() >= limits.maxSeconds) ||
+         (limits.cancel != nullptr && limits.cancel->load()))) {
+      aborted = true;
+      break;
+    }
+
+    if (depth == stack.size()) {
+      stack.resize(stack.size() * 2);
+    }
+    expand(position, stack[depth++]);
+  }
+
+  if (result.outcome != WINNABLE && !aborted) {
+    result.outcome = UNWINNABLE;
+  }
+  result.seconds = elapsed();
+  result.workers.resize(1);
+  result.workers[0].nodes = result.nodes;
+  result.workers[0].seconds = result.seconds;
+  return result;
+}
+
+void Solver::expand(const Position& position, Frame& frame) {
+  MoveList legal;
+  position.legalMoves(legal);
+  frame.moves.size = 0;
+  frame.next = 0;
+
+  for (const BoardMove& move : legal) {
+    if (Board::isTarget(move.toPile_) && isSafe(position, move)) {
+      frame.moves.add(move);
+      return;
+    }
+  }
+
+  // Insertion sort by score, best first; lists are short
+  int scores[MoveList::capacity];
+  for (const BoardMove& move : legal) {
+    const int moveScore = score(position, move);
+    int i = frame.moves.size;
+    frame.moves.add(move);
+    while (i > 0 && scores[i - 1] < moveScore) {
+      frame.moves.moves[i] = frame.moves.moves[i - 1];
+      scores[i] = scores[i - 1];
+      i--;
+    }
+    frame.moves.moves[i] = move;
+    scores[i] = moveScore;
+  }
+}
+
+bool Solver::isSafe(const Position& position, const BoardMove& move) {
+  // Taking a card off the waste pile regroups the draws in draw three
+  if (move.fromPile_ == Board::wasteIndex && position.getDrawCount() > 1) {
+    return false;
+  }
+  const PileState& from = position.getBoard().piles[move.fromPile_];
+  const CardState* card = from.getTopCard();
+  if (card->getRank() <= TWO) {
+    return true;
+  }
+  int heights[TARGET_PILE_AM];
+  for (Suit suit : allSuits) {
+    heights[suit] = position.targetHeight(suit);
+  }
+  return card->getRank() <= Foundations::safeRank(heights, card->getSuit());
+}
+
+int Solver::progress(const Position& position) {
+  const Board& board = position.getBoard();
+  int progress = 0;
+  for (int i = Board::firstTargetIndex; i < Board::pileAm; i++) {
+    progress += board.piles[i].getSize();
+  }
+  for (int i = Board::firstKlondikeIndex; i < Board::firstTargetIndex; i++) {
+    progress -= position.getMoveGenerator().getFirstFaceUp(i);
+  }
+  return progress;
+}
+
+int Solver::score(const Position& position, const BoardMove& move) {
+  const Board& board = position.getBoard();
+  switch (move.type_) {
+    case WASTE_TO_TARGET:
+    case KLONDIKE_TO_TARGET:
+      return 1000;
+    case KLONDIKE_TO_KLONDIKE: {
+      const int size = board.piles[move.fromPile_].getSize();
+      const int firstFaceUp =
+          position.getMoveGenerator().getFirstFaceUp(move.fromPile_);
+      if (size - move.nofCards_ != firstFaceUp) {
+        return 200;  // Splits a face-up run
+      }
+      // Uncovering a face-down card, more so in a deeper pile
+      return firstFaceUp > 0 ? 800 + firstFaceUp : 500;
+    }
+    case WASTE_TO_KLONDIKE:
+      return 600;
+    case DECK_TO_WASTE:
+      return 300;
+    case RECYCLE_DECK:
+      return 100;
+    default:
+      return 0;
+  }
+}
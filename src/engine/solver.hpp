@@ -0,0 +1,141 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "engine/gameState.hpp"
+#include "engine/position.hpp"
+#include "engine/transpositionTable.hpp"
+
+/**
+ * @brief Outcome of a solver search.
+ */
+enum Outcome {
+  WINNABLE,    ///< A winning move sequence was found.
+  UNWINNABLE,  ///< The whole game tree was searched without finding a win.
+  UNDECIDED    ///< The search hit a limit before it could decide.
+};
+
+/**
+ * @brief Bounds on the work a solver search may do.
+ *
+ * A value of 0 means no bound.
+ */
+struct SolverLimits {
+  uint64_t maxNodes = 0;   ///< Maximum number of positions to expand.
+  double maxSeconds = 0;   ///< Maximum search time in seconds.
+  const std::atomic<bool>* cancel = nullptr;  ///< Stops the search when set.
+};
+
+/**
+ * @brief Search statistics of one solver thread.
+ */
+struct WorkerStats {
+  uint64_t nodes = 0;   ///< Number of positions expanded by the thread.
+  uint64_t steals = 0;  ///< Number of subtrees taken from other threads.
+  double seconds = 0;   ///< Time the thread spent in the search.
+
+  /**
+   * @brief Get the search speed of the thread.
+   */
+  double nodesPerSecond() const { return seconds > 0 ? nodes / seconds : 0; }
+};
+
+/**
+ * @brief Result of a solver search.
+ */
+struct SolveResult {
+  Outcome outcome = UNDECIDED;       ///< Whether the deal can be won.
+  std::vector<BoardMove> solution;   ///< Winning moves, if WINNABLE.
+  std::vector<BoardMove> bestLine;   ///< Moves to the most advanced position.
+  uint64_t nodes = 0;                ///< Number of positions expanded.
+  double seconds = 0;                ///< Time spent searching.
+  std::vector<WorkerStats> workers;  ///< Statistics per search thread.
+};
+
+/**
+ * @class Solver
+ * @brief Depth-first Klondike solver for draw one and draw three.
+ *
+ * The search keeps every visited position in a transposition table and never
+ * expands a position twice. Cards that can never be needed on the table are
+ * moved to the target piles without trying alternatives, and the remaining
+ * moves are tried in order of how much progress they make.
+ *
+ * The solution lists the moves in the order they are made, including those
+ * pruning forced, and can be replayed with GameState::applyMove.
+ */
+class Solver {
+ public:
+  /// Bumped whenever a change to the rules or the pruning can change what a
+  /// search proves, so stored results of older solvers are not trusted.
+  static constexpr uint32_t version = 2;
+
+  /**
+   * @brief Construct a solver for a position.
+   * @param board The piles on the table.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   */
+  Solver(const Board& board, int drawCount);
+
+  /**
+   * @brief Construct a solver for the current position of a game.
+   * @param state The game, drawing three cards at a time in hard mode.
+   */
+  explicit Solver(const GameState& state);
+
+  /**
+   * @brief Search for a winning move sequence.
+   * @param limits Bounds on the search, none by default.
+   * @return The outcome, the winning moves and search statistics.
+   */
+  SolveResult solve(const SolverLimits& limits = SolverLimits());
+
+  /**
+   * @brief One level of the depth-first search.
+   */
+  struct Frame {
+    MoveList moves;  ///< Moves to try, best first.
+    int next;        ///< Index of the next move to try.
+    MoveUndo undo;   ///< Undo record of the move being explored.
+  };
+
+  /**
+   * @brief Fill a frame with the moves to try from a position.
+   *
+   * If a card can safely go to a target pile, that is the only move listed.
+   *
+   * @param position The position to expand.
+   * @param frame The frame to fill.
+   */
+  static void expand(const Position& position, Frame& frame);
+
+  /**
+   * @brief Measure how far a position is from the start of a game.
+   * @param position The position.
+   * @return Cards on the target piles minus face-down Klondike cards.
+   */
+  static int progress(const Position& position);
+
+ private:
+  Position root_;            ///< Position the search starts from.
+  TranspositionTable seen_;  ///< Canonical hashes of expanded positions.
+
+  /**
+   * @brief Check whether moving a card to a target pile can never hurt.
+   * @param position The position the move is made on.
+   * @param move A move to a target pile.
+   */
+  static bool isSafe(const Position& position, const BoardMove& move);
+
+  /**
+   * @brief Score a move for ordering, higher is tried first.
+   * @param position The position the move is made on.
+   * @param move A legal move.
+   */
+  static int score(const Position& position, const BoardMove& move);
+};
+
+#endif  // SOLVER_HPP
@@ -0,0 +1,247 @@
+#include "engine/solverCache.hpp"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+static const char cacheMagic[4] = {'K', 'S', 'C', '1'};
+
+/**
+ * @brief Start of the file, in native byte order.
+ */
+struct SolverCache::Header {
+  char magic[4];                   ///< "KSC1".
+  uint32_t slotCount;              ///< Number of index slots, a power of 2.
+  uint64_t dataCapacity;           ///< Bytes of record space.
+  std::atomic<uint64_t> dataSize;  ///< Bytes of record space in use.
+  std::atomic<uint64_t> entries;   ///< Number of records.
+  uint32_t solverVersion;          ///< Solver::version of the results.
+  uint32_t reserved32;             ///< Unused, zero.
+  uint64_t reserved[3];            ///< Pads the header to 64 bytes.
+};
+
+/**
+ * @brief Index slot. The offset is published before the key.
+ */
+struct SolverCache::Slot {
+  std::atomic<uint64_t> key;     ///< Hash of the deal, 0 when free.
+  std::atomic<uint64_t> offset;  ///< Record offset in the record area.
+};
+
+/**
+ * @brief Fixed part of a record, followed by its solution moves.
+ */
+struct SolverCache::Record {
+  uint64_t words[DealId::wordAm];  ///< Id of the deal.
+  uint64_t nodes;                  ///< Positions the solver expanded.
+  uint32_t solutionLength;         ///< Number of solution moves.
+  uint8_t drawCount;               ///< Cards drawn at a time.
+  uint8_t outcome;                 ///< WINNABLE or UNWINNABLE.
+  uint8_t reserved[2];             ///< Pads the record to 8 bytes.
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) &&
+                  std::atomic<uint64_t>::is_always_lock_free,
+              "The mapped file needs address-free 64-bit atomics");
+static_assert(sizeof(BoardMove) == 4, "Moves are stored as 4 bytes");
+
+SolverCache::SolverCache()
+    : fd_(-1),
+      map_(nullptr),
+      mapSize_(0),
+      header_(nullptr),
+      slots_(nullptr),
+      data_(nullptr) {}
+
+SolverCache::~SolverCache() { close(); }
+
+bool SolverCache::open(const std::string& path, uint32_t slots,
+                       uint64_t dataSize) {
+  close();
+  uint32_t slotCount = 1;
+  while (slotCount < slots) {
+    slotCount <<= 1;
+  }
+
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd_ < 0) {
+    return false;
+  }
+
+  // Whoever locks an empty file first sets it up
+  Header header{};
+  flock(fd_, LOCK_EX);
+  struct stat status;
+  bool ok = fstat(fd_, &status) == 0;
+  if (ok && status.st_size == 0) {
+    std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.slotCount = slotCount;
+    header.dataCapacity = dataSize;
+    header.solverVersion = Solver::version;
+    const off_t size = sizeof(Header) + slotCount * sizeof(Slot) + dataSize;
+    ok = ftruncate(fd_, size) == 0 &&
+         pwrite(fd_, &header, sizeof(header), 0) == sizeof(header);
+  } else if (ok) {
+    ok = pread(fd_, &header, sizeof(header), 0) == sizeof(header) &&
+         std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) == 0 &&
+         header.slotCount > 0 &&
+         (header.slotCount & (header.slotCount - 1)) == 0 &&
+         static_cast<uint64_t>(status.st_size) ==
+             sizeof(Header) + header.slotCount * sizeof(Slot) +
+                 header.dataCapacity;
+    if (ok && header.solverVersion != Solver::version) {
+      // Results of another solver can be wrong for this one. Unlink the file
+      // unless another process already replaced it, and start a new one.
+      struct stat current;
+      if (stat(path.c_str(), &current) == 0 &&
+          current.st_dev == status.st_dev && current.st_ino == status.st_ino) {
+        unlink(path.c_str());
+      }
+      const bool replaced = stat(path.c_str(), &current) != 0 ||
+                            current.st_dev != status.st_dev ||
+                            current.st_ino != status.st_ino;
+      flock(fd_, LOCK_UN);
+      close();
+      return replaced && open(path, slots, dataSize);
+    }
+  }
+  flock(fd_, LOCK_UN);
+
+  if (ok) {
+    mapSize_ = sizeof(Header) + header.slotCount * sizeof(Slot) +
+               header.dataCapacity;
+    void* map =
+        mmap(nullptr, mapSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    ok = map != MAP_FAILED;
+    if (ok) {
+      map_ = static_cast<char*>(map);
+      header_ = reinterpret_cast<Header*>(map_);
+      slots_ = reinterpret_cast<Slot*>(map_ + sizeof(Header));
+      data_ = map_ + sizeof(Header) + header.slotCount * sizeof(Slot);
+    }
+  }
+  if (!ok) {
+    close();
+  }
+  return ok;
+}
+
+void SolverCache::close() {
+  if (map_ != nullptr) {
+    munmap(map_, mapSize_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+  fd_ = -1;
+  map_ = nullptr;
+  mapSize_ = 0;
+  header_ = nullptr;
+  slots_ = nullptr;
+  data_ = nullptr;
+}
+
+bool SolverCache::find(const DealId& id, int drawCount,
+                       CachedSolve& result) const {
+  if (!isOpen()) {
+    return false;
+  }
+  const uint64_t wanted = key(id, drawCount);
+  const uint64_t mask = header_->slotCount - 1;
+  for (uint64_t i = 0, slot = wanted & mask; i <= mask;
+       i++, slot = (slot + 1) & mask) {
+    const uint64_t found = slots_[slot].key.load(std::memory_order_acquire);
+    if (found == 0) {
+      return false;
+    }
+    if (found != wanted) {
+      continue;
+    }
+    const uint64_t offset = slots_[slot].offset.load(std::memory_order_acquire);
+    const Record* record = reinterpret_cast<const Record*>(data_ + offset);
+    if (record->drawCount != drawCount ||
+        std::memcmp(record->words, id.words, sizeof(id.words)) != 0) {
+      continue;  // Another deal with the same key
+    }
+    result.outcome = static_cast<Outcome>(record->outcome);
+    result.nodes = record->nodes;
+    result.solution.resize(record->solutionLength);
+    std::memcpy(result.solution.data(), record + 1,
+                record->solutionLength * sizeof(BoardMove));
+    return true;
+  }
+  return false;
+}
+
+bool SolverCache::insert(const DealId& id, int drawCount,
+                         const SolveResult& result) {
+  if (!isOpen() || result.outcome == UNDECIDED) {
+    return false;
+  }
+  const uint64_t wanted = key(id, drawCount);
+  const uint64_t mask = header_->slotCount - 1;
+  const uint64_t recordSize =
+      (sizeof(Record) + result.solution.size() * sizeof(BoardMove) + 7) &
+      ~uint64_t(7);
+
+  // Threads of this process share the file lock, so they queue up first
+  std::lock_guard<std::mutex> lock(appendMutex_);
+  flock(fd_, LOCK_EX);
+  bool stored = false;
+  const uint64_t entries = header_->entries.load(std::memory_order_relaxed);
+  const uint64_t dataSize = header_->dataSize.load(std::memory_order_relaxed);
+  if ((entries + 1) * 4 <= (mask + 1) * 3 &&
+      dataSize + recordSize <= header_->dataCapacity) {
+    uint64_t slot = wanted & mask;
+    bool present = false;
+    while (uint64_t found = slots_[slot].key.load(std::memory_order_relaxed)) {
+      if (found == wanted) {
+        const Record* record = reinterpret_cast<const Record*>(
+            data_ + slots_[slot].offset.load(std::memory_order_relaxed));
+        present = record->drawCount == drawCount &&
+                  std::memcmp(record->words, id.words, sizeof(id.words)) == 0;
+        if (present) {
+          break;
+        }
+      }
+      slot = (slot + 1) & mask;
+    }
+
+    if (!present) {
+      Record* record = reinterpret_cast<Record*>(data_ + dataSize);
+      std::memcpy(record->words, id.words, sizeof(id.words));
+      record->nodes = result.nodes;
+      record->solutionLength = result.solution.size();
+      record->drawCount = drawCount;
+      record->outcome = result.outcome;
+      std::memcpy(record + 1, result.solution.data(),
+                  result.solution.size() * sizeof(BoardMove));
+
+      // Readers find the key only after the record and offset are in place
+      header_->dataSize.store(dataSize + recordSize,
+                              std::memory_order_relaxed);
+      slots_[slot].offset.store(dataSize, std::memory_order_release);
+      slots_[slot].key.store(wanted, std::memory_order_release);
+      header_->entries.store(entries + 1, std::memory_order_release);
+      stored = true;
+    }
+  }
+  flock(fd_, LOCK_UN);
+  return stored;
+}
+
+size_t SolverCache::size() const {
+  return isOpen() ? header_->entries.load(std::memory_order_acquire) : 0;
+}
+
+uint64_t SolverCache::key(const DealId& id, int drawCount) {
+  uint64_t hash = static_cast<uint64_t>(drawCount);
+  for (uint64_t word : id.words) {
+    hash = splitMix64(hash ^ word);
+  }
+  return hash == 0 ? 1 : hash;
+}
@@ -0,0 +1,128 @@
+#ifndef SOLVER_CACHE_HPP
+#define SOLVER_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "engine/dealId.hpp"
+#include "engine/solver.hpp"
+
+/**
+ * @brief Solver result of a deal as stored in a SolverCache.
+ */
+struct CachedSolve {
+  Outcome outcome = UNDECIDED;      ///< WINNABLE or UNWINNABLE.
+  std::vector<BoardMove> solution;  ///< Moves that win, if winnable.
+  uint64_t nodes = 0;               ///< Positions the solver expanded.
+};
+
+/**
+ * @class SolverCache
+ * @brief Memory-mapped file of solved deals, keyed by deal id and draw count.
+ *
+ * The file holds a fixed-size open addressing index followed by an append-only
+ * record area. The file is sparse, so unused space costs no disk.
+ *
+ * Lookups probe the index with atomic loads and never lock, so any number of
+ * threads and processes can read while another one appends. Appends take a
+ * lock on the file, which makes them safe between processes as well.
+ * A record is written in full before its index slot is published.
+ *
+ * Only decided results are stored, since an UNDECIDED result depends on the
+ * limits of the search. The header records Solver::version, and a file
+ * written by another solver version is replaced by a new, empty one.
+ *
+ * Like ConcurrentTranspositionTable, the cache never grows: appends fail once
+ * the index is 3/4 full or the record area is used up.
+ *
+ * Uses POSIX file mapping and locking.
+ */
+class SolverCache {
+ public:
+  static constexpr uint32_t defaultSlots = 1 << 16;         ///< Index slots.
+  static constexpr uint64_t defaultDataSize = 64ull << 20;  ///< Record bytes.
+
+  /**
+   * @brief Construct a closed cache.
+   */
+  SolverCache();
+
+  /**
+   * @brief Unmap and close the file.
+   */
+  ~SolverCache();
+
+  SolverCache(const SolverCache&) = delete;
+  SolverCache& operator=(const SolverCache&) = delete;
+
+  /**
+   * @brief Map a cache file, creating it if it does not exist.
+   * @param path Path of the file.
+   * @param slots Number of index slots of a new file, rounded up to a power
+   * of two. An existing file keeps its own size.
+   * @param dataSize Bytes of record space of a new file.
+   * @return False if the file cannot be created, mapped, or is not a cache.
+   * A cache of another Solver::version is unlinked and a new file created in
+   * its place; processes that still map the old file keep using it.
+   */
+  bool open(const std::string& path, uint32_t slots = defaultSlots,
+            uint64_t dataSize = defaultDataSize);
+
+  /**
+   * @brief Unmap and close the file, if open.
+   */
+  void close();
+
+  /**
+   * @brief Check whether a file is mapped.
+   */
+  bool isOpen() const { return map_ != nullptr; }
+
+  /**
+   * @brief Look up a deal, without locking.
+   * @param id Id of the deal's card order.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * @param result Set to the stored result if found.
+   * @return True if the deal is in the cache.
+   */
+  bool find(const DealId& id, int drawCount, CachedSolve& result) const;
+
+  /**
+   * @brief Append the result of a deal.
+   * @param id Id of the deal's card order.
+   * @param drawCount Number of cards drawn from the deck at a time, 1 or 3.
+   * @param result The solver result.
+   * @return True if stored; false if undecided, already present, or the
+   * cache is full.
+   */
+  bool insert(const DealId& id, int drawCount, const SolveResult& result);
+
+  /**
+   * @brief Get the number of deals stored.
+   */
+  size_t size() const;
+
+ private:
+  struct Header;
+  struct Slot;
+  struct Record;
+
+  int fd_;                  ///< The open file, or -1.
+  char* map_;               ///< The mapped file, or nullptr.
+  size_t mapSize_;          ///< Size of the mapping in bytes.
+  Header* header_;          ///< File header at the start of the mapping.
+  Slot* slots_;             ///< The index.
+  char* data_;              ///< Start of the record area.
+  std::mutex appendMutex_;  ///< Orders appends between threads.
+
+  /**
+   * @brief Hash a deal id and draw count into a non-zero index key.
+   */
+  static uint64_t key(const DealId& id, int drawCount);
+};
+
+#endif  // SOLVER_CACHE_HPP
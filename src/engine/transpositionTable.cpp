@@ -0,0 +1,99 @@
+#include "engine/transpositionTable.hpp"
+
+TranspositionTable::TranspositionTable(size_t capacity) : size_(0) {
+  size_t slots = 16;
+  while (slots < capacity) {
+    slots <<= 1;
+  }
+  slots_.assign(slots, emptyKey);
+  mask_ = slots - 1;
+}
+
+bool TranspositionTable::insert(uint64_t key) {
+  key = remap(key);
+  size_t i = home(key);
+  while (slots_[i] != emptyKey) {
+    if (slots_[i] == key) {
+      return false;
+    }
+    i = (i + 1) & mask_;
+  }
+  slots_[i] = key;
+  if (++size_ * 2 > slots_.size()) {
+    grow();
+  }
+  return true;
+}
+
+bool TranspositionTable::contains(uint64_t key) const {
+  key = remap(key);
+  for (size_t i = home(key); slots_[i] != emptyKey; i = (i + 1) & mask_) {
+    if (slots_[i] == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void TranspositionTable::clear() {
+  slots_.assign(slots_.size(), emptyKey);
+  size_ = 0;
+}
+
+void TranspositionTable::grow() {
+  std::vector<uint64_t> old;
+  old.swap(slots_);
+  slots_.assign(old.size() * 2, emptyKey);
+  mask_ = slots_.size() - 1;
+  for (uint64_t key : old) {
+    if (key == emptyKey) continue;
+    size_t i = home(key);
+    while (slots_[i] != emptyKey) {
+      i = (i + 1) & mask_;
+    }
+    slots_[i] = key;
+  }
+}
+
+ConcurrentTranspositionTable::ConcurrentTranspositionTable(size_t capacity)
+    : size_(0), full_(false) {
+  size_t slots = 16;
+  while (slots < capacity) {
+    slots <<= 1;
+  }
+  slots_.reset(new std::atomic<uint64_t>[slots]);
+  mask_ = slots - 1;
+  clear();
+}
+
+bool ConcurrentTranspositionTable::insert(uint64_t key) {
+  key = key == emptyKey ? 1 : key;
+  if (size_.load(std::memory_order_relaxed) * 4 >= capacity() * 3) {
+    full_.store(true, std::memory_order_relaxed);
+    return false;
+  }
+  size_t i = (key * 0x9e3779b97f4a7c15ull >> 32) & mask_;
+  while (true) {
+    uint64_t slot = slots_[i].load(std::memory_order_relaxed);
+    if (slot == emptyKey) {
+      if (slots_[i].compare_exchange_strong(slot, key,
+                                            std::memory_order_relaxed)) {
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      // Another thread claimed the slot first, slot now holds its key
+    }
+    if (slot == key) {
+      return false;
+    }
+    i = (i + 1) & mask_;
+  }
+}
+
+void ConcurrentTranspositionTable::clear() {
+  for (size_t i = 0; i <= mask_; i++) {
+    slots_[i].store(emptyKey, std::memory_order_relaxed);
+  }
+  size_.store(0, std::memory_order_relaxed);
+  full_.store(false, std::memory_order_relaxed);
+}
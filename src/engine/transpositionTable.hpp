@@ -0,0 +1,131 @@
+#ifndef TRANSPOSITION_TABLE_HPP
+#define TRANSPOSITION_TABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class TranspositionTable
+ * @brief Set of position hashes already visited by a search.
+ *
+ * Open addressing with linear probing over 64-bit keys. The table doubles
+ * when it is half full, so probes stay short.
+ */
+class TranspositionTable {
+ public:
+  /**
+   * @brief Construct a table.
+   * @param capacity Initial number of slots, rounded up to a power of two.
+   */
+  explicit TranspositionTable(size_t capacity = 1 << 16);
+
+  /**
+   * @brief Add a key to the table.
+   * @param key Hash of a position.
+   * @return True if the key was new, false if it was already present.
+   */
+  bool insert(uint64_t key);
+
+  /**
+   * @brief Check whether a key is in the table.
+   * @param key Hash of a position.
+   */
+  bool contains(uint64_t key) const;
+
+  /**
+   * @brief Get the number of keys in the table.
+   */
+  size_t size() const { return size_; }
+
+  /**
+   * @brief Remove all keys, keeping the allocated slots.
+   */
+  void clear();
+
+ private:
+  static constexpr uint64_t emptyKey = 0;  ///< Marks a free slot.
+
+  std::vector<uint64_t> slots_;  ///< The keys, emptyKey when free.
+  size_t mask_;                  ///< Number of slots minus one.
+  size_t size_;                  ///< Number of keys stored.
+
+  /**
+   * @brief Map a key so that it never equals emptyKey.
+   */
+  static uint64_t remap(uint64_t key) { return key == emptyKey ? 1 : key; }
+
+  /**
+   * @brief Get the first slot probed for a key.
+   *
+   * Keys are scrambled first so that hashes with weak low bits still spread
+   * over the table.
+   */
+  size_t home(uint64_t key) const {
+    return (key * 0x9e3779b97f4a7c15ull >> 32) & mask_;
+  }
+
+  /**
+   * @brief Double the number of slots and reinsert all keys.
+   */
+  void grow();
+};
+
+/**
+ * @class ConcurrentTranspositionTable
+ * @brief Set of position hashes shared by the threads of a parallel search.
+ *
+ * Lock-free open addressing: a key is claimed with a compare-and-swap on the
+ * first free slot of its probe sequence. The table cannot grow while threads
+ * use it, so it reports when it is full instead, and a search must then stop,
+ * since the positions it could not record were never explored.
+ */
+class ConcurrentTranspositionTable {
+ public:
+  /**
+   * @brief Construct a table.
+   * @param capacity Number of slots, rounded up to a power of two. The table
+   * is full when three quarters of them are used.
+   */
+  explicit ConcurrentTranspositionTable(size_t capacity = 1 << 22);
+
+  /**
+   * @brief Add a key to the table, safe to call from any thread.
+   * @param key Hash of a position.
+   * @return True if the key was new, false if it was already present or the
+   * table is full.
+   */
+  bool insert(uint64_t key);
+
+  /**
+   * @brief Check whether an insert failed because the table was full.
+   */
+  bool isFull() const { return full_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Get the number of keys in the table.
+   */
+  size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Get the number of slots in the table.
+   */
+  size_t capacity() const { return mask_ + 1; }
+
+  /**
+   * @brief Remove all keys. Not safe while other threads insert.
+   */
+  void clear();
+
+ private:
+  static constexpr uint64_t emptyKey = 0;  ///< Marks a free slot.
+
+  std::unique_ptr<std::atomic<uint64_t>[]> slots_;  ///< The keys.
+  size_t mask_;                                     ///< Slots minus one.
+  std::atomic<size_t> size_;                        ///< Keys stored.
+  std::atomic<bool> full_;  ///< Whether an insert found the table full.
+};
+
+#endif  // TRANSPOSITION_TABLE_HPP
@@ -0,0 +1,31 @@
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include <cstdint>
+
+#include "engine/cardState.hpp"
+#include "engine/random.hpp"
+
+/**
+ * @brief Get the Zobrist key of a card lying at a place on the table.
+ *
+ * The hash of a pile is the XOR of the keys of all its cards. A key depends
+ * on the kind of the pile, the depth in the pile and the face of the card, so
+ * moving or flipping cards only XORs the keys of those cards in and out.
+ * Keys are computed on demand instead of read from a table of 20k entries.
+ *
+ * @param pile Kind of the pile, a PileKind. The deck and the waste pile are
+ * the only piles of their kinds.
+ * @param depth Index of the card from the bottom of the pile.
+ * @param card The card with its face.
+ * @return The key.
+ */
+constexpr uint64_t zobristKey(int pile, int depth, const CardState& card) {
+  return splitMix64(
+      (static_cast<uint64_t>(pile * DECK_SIZE + depth) * DECK_SIZE +
+       card.getIndex()) *
+          2 +
+      card.isFaceUp());
+}
+
+#endif  // ZOBRIST_HPP
@@ -2,15 +2,31 @@
 
 #include <exception>
 
-Game::Game(QObject* parent)
+#include "engine/deal.hpp"
+
+Game::Game(QObject* parent) : Game(randomDealNumber(), parent) {}
+
+Game::Game(uint64_t dealNumber, QObject* parent)
     : klondikePiles_(KLONDIKE_PILE_AM),
       targetPiles_(TARGET_PILE_AM),
+      dealNumber_(dealNumber),
       points_(0),
       moves_(0),
       hints_(0),
       undos_(0),
+      hardMode_(false),
+      autoPlay_(false),
       isWon_(false),
       prevHint_(nullptr),
+      hintDeadline_(defaultHintDeadline),
+      hintPending_(false),
+      hintWanted_(false),
+      solverCache_(nullptr),
+      deadEndDeadline_(defaultDeadEndDeadline),
+      isDeadEnd_(false),
+      reachedDeadEnd_(false),
+      deadEndMoves_(0),
+      difficulty_(-1),
       maxHistory_(0xFF),
       QObject(parent) {
   initDeck();
@@ -18,10 +34,16 @@ Game::Game(QObject* parent)
   initKlondikePiles();
   initTargetPiles();
   initTimer();
+  for (int i = 0; i < Board::pileAm; i++) {
+    getPile(i)->setIndex(i);
+  }
+  // Only the outcome of a dead end search is needed
+  deadEndEngine_.setPlanLength(1);
 }
 
 void Game::initDeck() {
-  deck_ = new Deck();
+  deck_ = new Deck(dealNumber_);
+  dealId_ = deck_->getDealId();
   deck_->setParent(this);
   connect(deck_, &Pile::cardClickMove, this, &Game::handleDeckClicked);
 }
@@ -75,37 +97,57 @@ void Game::startGame() {
     for (size_t j = 0; j <= i; j++) {
       deck_->transferCards(*klondikePile);
     }
-    klondikePile->getTopCard()->flip();
+    klondikePile->flipTopCard(true);
     klondikePile->updateVisuals();
   }
+  for (int i = 0; i < Board::pileAm; i++) {
+    syncPile(getPile(i));
+  }
+  loadCachedSolve();
+  requestHint(HintEngine::BACKGROUND);
   timer_->start(1000);
 }
 
 // Update stat.CSV when game is deconstructed and moves have been made
 Game::~Game() {
+  // Once cancelled, the engines post no more results to this
+  hintEngine_.cancel();
+  deadEndEngine_.cancel();
   if (moves_ > 0 || undos_ > 0) {
     updateStats();
   }
 }
 
 void Game::logMove(const Move& move) {
+  // The board mirror still holds the position before the move
+  uint64_t previousHash = board_.hash();
+
   // Add move to history
   addToHistory(move);
   moves_++;
   points_ += move.pointChange_;
 
   // Determine if top card is flipped in KlondikePile.
-  KlondikePile* kPile = dynamic_cast<KlondikePile*>(move.fromPile_);
-  if (kPile && kPile->flipTopCard(true)) {
-    addToHistory(
-        Move(FLIP_KLONDIKE, move.fromPile_, move.toPile_, 0, turnOverPoints));
-    points_ += turnOverPoints;
-  }
+  logFlip(move);
 
   // Update visuals
   move.fromPile_->updateVisuals();
   move.toPile_->updateVisuals();
+  syncPile(move.fromPile_);
+  syncPile(move.toPile_);
   prevHint_ = nullptr;
+  cancelHint();
+  followHintPlan(previousHash,
+                 {move.type_, static_cast<int8_t>(pileIndex(move.fromPile_)),
+                  static_cast<int8_t>(pileIndex(move.toPile_)),
+                  static_cast<int8_t>(move.nofCards_)});
+  if (autoPlay_) {
+    autoPlaySafeCards();
+  }
+
+  if (!this->hasWon() && canAutoFinish()) {
+    autoFinish();
+  }
 
   // Update game view labels
   emit gameStateChange(points_, moves_);
@@ -115,6 +157,54 @@ void Game::logMove(const Move& move) {
     isWon_ = true;
     soundManager_.playWinSound();
     emit gameWon(points_);
+  } else {
+    requestHint(HintEngine::BACKGROUND);
+    checkDeadEnd();
+  }
+}
+
+void Game::logFlip(const Move& move) {
+  KlondikePile* kPile = dynamic_cast<KlondikePile*>(move.fromPile_);
+  if (kPile && kPile->flipTopCard(true)) {
+    addToHistory(Move(FLIP_KLONDIKE, move.fromPile_, move.toPile_, 0,
+                      turnOverPoints, true));
+    points_ += turnOverPoints;
+  }
+}
+
+void Game::autoPlaySafeCards() {
+  vector<Pile*> fromPiles(klondikePiles_.begin(), klondikePiles_.end());
+  // Taking a card off the waste pile regroups the draws in hard mode
+  if (!hardMode_) {
+    fromPiles.push_back(wastePile_);
+  }
+
+  bool played = true;
+  while (played) {
+    played = false;
+    for (Pile* fromPile : fromPiles) {
+      Card* card = fromPile->getTopCard();
+      if (card == nullptr || !card->isFaceUp() ||
+          foundations_.safeCard(card->getSuit()) != card->getIndex()) {
+        continue;
+      }
+      Pile* toPile = findLegalPile(card);
+      if (dynamic_cast<TargetPile*>(toPile) == nullptr) {
+        continue;
+      }
+
+      fromPile->transferCards(*toPile, 1);
+      const MoveType type = determineMove(fromPile, toPile);
+      const Move move(type, fromPile, toPile, 1, pointChange(type), true);
+      addToHistory(move);
+      points_ += move.pointChange_;
+      logFlip(move);
+      fromPile->updateVisuals();
+      toPile->updateVisuals();
+      syncPile(fromPile);
+      syncPile(toPile);
+      played = true;
+    }
   }
 }
 
@@ -150,6 +240,20 @@ void Game::updateStats() {
   stats.hintCount += hints_;
   stats.undoCount += undos_;
 
+  if (reachedDeadEnd_) {
+    stats.deadEnds++;
+    stats.deadEndMoves += moves_ > deadEndMoves_ ? moves_ - deadEndMoves_ : 0;
+  }
+
+  if (difficulty_ >= 0) {
+    stats.ratedGames++;
+    stats.totalDifficulty += difficulty_;
+    if (isWon_) {
+      stats.ratedWins++;
+      stats.wonDifficulty += difficulty_;
+    }
+  }
+
   stats.totalPoints += points_;
   if (isWon_) stats.bestPoints = std::max(stats.bestPoints, points_);
   stats.avgPoints = stats.totalPoints / games;
@@ -170,80 +274,136 @@ void Game::undo() {
     moves_--;
     undos_++;
     prevHint_ = nullptr;
+    cancelHint();
 
-    // Check if card was flipped in KlondikePile
-    if (movehistory_.back().type_ == FLIP_KLONDIKE) {
-      const Move& flipMove = movehistory_.back();
-      flipMove.fromPile_->flipTopCard(false);
-      points_ -= flipMove.pointChange_;
+    // Undo the last move and everything chained to it
+    bool chained = true;
+    while (chained && !movehistory_.empty()) {
+      const Move move = movehistory_.back();
       movehistory_.pop_back();
+      undoMove(move);
+      chained = move.chained_;
     }
 
-    // Get last move
-    const Move& move = movehistory_.back();
-    movehistory_.pop_back();
+    requestHint(HintEngine::BACKGROUND);
+    checkDeadEnd();
+    emit gameStateChange(points_, moves_);
+  }
+}
 
-    if (move.type_ == RECYCLE_DECK) {
-      deck_->undoRecycle(*wastePile_);
-    } else if (move.type_ == DECK_TO_WASTE) {
-      wastePile_->undoAddFromDeck(*deck_, move.nofCards_);
-    } else {
-      move.toPile_->transferCards(*move.fromPile_, move.nofCards_);
-    }
+void Game::undoMove(const Move& move) {
+  if (move.type_ == FLIP_KLONDIKE) {
+    move.fromPile_->flipTopCard(false);
+  } else if (move.type_ == RECYCLE_DECK) {
+    deck_->undoRecycle(*wastePile_);
+  } else if (move.type_ == DECK_TO_WASTE) {
+    wastePile_->undoAddFromDeck(*deck_, move.nofCards_);
+  } else {
+    move.toPile_->transferCards(*move.fromPile_, move.nofCards_);
+  }
 
-    // Update board
-    points_ -= move.pointChange_;
-    move.toPile_->updateVisuals();
-    move.fromPile_->updateVisuals();
-    emit gameStateChange(points_, moves_);
+  // Update board
+  points_ -= move.pointChange_;
+  move.toPile_->updateVisuals();
+  move.fromPile_->updateVisuals();
+  syncPile(move.fromPile_);
+  syncPile(move.toPile_);
+}
+
+bool Game::canAutoFinish() const {
+  if (!deck_->isEmpty() || !wastePile_->isEmpty()) {
+    return false;
   }
+  for (auto& klondikePile : klondikePiles_) {
+    for (size_t i = 0; i < klondikePile->getSize(); i++) {
+      if (!klondikePile->getCardFromBack(i)->isFaceUp()) {
+        return false;
+      }
+    }
+  }
+  return true;
 }
 
-int Game::pointChange(MoveType move) const {
-  int rawChange;
-  switch (move) {
-    case (WASTE_TO_KLONDIKE):
-      rawChange = wToKPoints;
-      break;
-    case (WASTE_TO_TARGET):
-      rawChange = wToTPoints;
-      break;
-    case (KLONDIKE_TO_TARGET):
-      rawChange = kToTPoints;
-      break;
-    case (KLONDIKE_TO_KLONDIKE):
-      rawChange = kToKPoints;
-      break;
-    case (FLIP_KLONDIKE):
-      rawChange = turnOverPoints;
-      break;
-    case (TARGET_TO_KLONDIKE):
-      rawChange = tToKPoints;
-      break;
-    case (DECK_TO_WASTE):
-      rawChange = dToWPoints;
-      break;
-    case (RECYCLE_DECK):
-      rawChange = recycleDeckPoints;
+void Game::autoFinish() {
+  vector<Card*> cards;
+  while (true) {
+    // Play the lowest card that fits, so the targets fill up evenly
+    Card* card = nullptr;
+    KlondikePile* fromPile = nullptr;
+    TargetPile* toPile = nullptr;
+    for (auto& klondikePile : klondikePiles_) {
+      Card* topCard = klondikePile->getTopCard();
+      if (topCard == nullptr ||
+          (card != nullptr && topCard->getRank() >= card->getRank())) {
+        continue;
+      }
+      for (auto& targetPile : targetPiles_) {
+        if (targetPile->isValid(*topCard)) {
+          card = topCard;
+          fromPile = klondikePile;
+          toPile = targetPile;
+          break;
+        }
+      }
+    }
+    if (card == nullptr) {
       break;
-    default:
-      rawChange = 0;
+    }
+    cards.push_back(card);
+
+    // The first move starts the batch, the rest are chained to it
+    fromPile->transferCards(*toPile, 1);
+    const int points = pointChange(KLONDIKE_TO_TARGET);
+    points_ += points;
+    addToHistory(Move(KLONDIKE_TO_TARGET, fromPile, toPile, 1, points,
+                      cards.size() > 1));
+  }
+  if (cards.empty()) {
+    return;
+  }
+  moves_++;
+
+  for (int i = 0; i < Board::pileAm; i++) {
+    syncPile(getPile(i));
   }
-  // Points cannot be negative, also prevent int underflow
-  if (rawChange < 0 && points_ < -rawChange) {
-    rawChange = -points_;
+
+  // One flight of cards, each leaving a little after the previous one
+  for (size_t i = 0; i < cards.size(); i++) {
+    Pile* targetPile = cards[i]->getPile();
+    QPointF startPos = targetPile->mapFromScene(cards[i]->getPrevScenePos());
+    targetPile->setZValue(2);
+    cards[i]->animateMove(startPos, QPointF(0, 0), finishMoveTime,
+                          i * finishStagger);
   }
-  return rawChange;
+  soundManager_.playMoveSound();
+}
+
+int Game::pointChange(MoveType move) const {
+  return ::pointChange(move, points_);
 }
 
 void Game::changeSettings(const Settings& settings) {
-  hardMode_ = settings.isHardModeEnabled;
+  if (hardMode_ != settings.isHardModeEnabled) {
+    toggleHardMode();
+  }
   hintsEnabled_ = settings.isHintsEnabled;
+  autoPlay_ = settings.isAutoPlayEnabled;
   soundManager_.setVolume(settings.volume);
   qDebug() << "Updated settings:";
   qDebug() << "Volume:" << settings.volume;
   qDebug() << "Hints Enabled:" << settings.isHintsEnabled;
   qDebug() << "Hard Mode Enabled:" << settings.isHardModeEnabled;
+  qDebug() << "Auto-play Enabled:" << settings.isAutoPlayEnabled;
+}
+
+void Game::toggleHardMode() {
+  hardMode_ = !hardMode_;
+  // Hints depend on the number of cards drawn
+  cancelHint();
+  hintCache_.clear();
+  lostPositions_.clear();
+  // Also cancels the check for the old mode, whose verdict would not hold
+  checkDeadEnd();
 }
 
 int Game::attemptMove(Card* card, Pile* fromPile, Pile* toPile) {
@@ -311,15 +471,178 @@ MoveType Game::determineMove(Pile* fromPile, Pile* toPile) const {
 }
 
 void Game::hint() {
-  if (prevHint_ == nullptr) {
-    hints_ += 1;
+  auto cached = hintCache_.find(hash());
+  if (cached != hintCache_.end()) {
+    if (prevHint_ == nullptr) {
+      hints_ += 1;
+    }
+    showHint(cached->second);
+    return;
+  }
+  if (hintWanted_) {
+    return;
+  }
+  hints_ += 1;
+  hintWanted_ = true;
+  requestHint(HintEngine::INTERACTIVE);
+}
+
+vector<BoardMove> Game::getHintPlan() const {
+  auto cached = hintCache_.find(hash());
+  if (cached == hintCache_.end()) {
+    return {};
+  }
+  return cached->second.moves;
+}
+
+void Game::requestHint(HintEngine::Priority priority) {
+  if (hintPending_ || hintCache_.count(hash()) > 0) {
+    return;
+  }
+  hintPending_ = true;
+  // The search ends on the hint thread, store it from the event loop
+  hintEngine_.request(
+      board_, hardMode_ ? 3 : 1, hintDeadline_,
+      [this](const HintResult& result) {
+        QMetaObject::invokeMethod(
+            this, [this, result]() { storeHint(result); },
+            Qt::QueuedConnection);
+      },
+      priority);
+}
+
+void Game::storeHint(const HintResult& result) {
+  // Posted before the mode changed, see toggleHardMode
+  if (result.drawCount != (hardMode_ ? 3 : 1)) {
+    return;
+  }
+  cacheHint(result);
+  storeDeadEnd(result);
+  if (!hintPending_ || result.hash != hash()) {
+    return;
+  }
+  hintPending_ = false;
+  if (hintWanted_) {
+    hintWanted_ = false;
+    showHint(result);
+  }
+}
+
+void Game::showHint(const HintResult& result) {
+  if (result.moves.empty()) {
     prevHint_ = findHint();
+  } else {
+    prevHint_ = moveCard(result.moves[0]);
+    getPile(result.moves[0].toPile_)->highlight();
   }
   if (prevHint_ != nullptr) {
     prevHint_->animateGlow();
   }
 }
 
+void Game::followHintPlan(uint64_t previousHash, const BoardMove& move) {
+  auto cached = hintCache_.find(previousHash);
+  if (cached == hintCache_.end() || cached->second.outcome != WINNABLE ||
+      cached->second.moves.size() < 2 || !(cached->second.moves[0] == move)) {
+    return;
+  }
+  HintResult next = cached->second;
+  next.hash = hash();
+  next.moves.erase(next.moves.begin());
+  cacheHint(next);
+}
+
+void Game::checkDeadEnd() {
+  deadEndEngine_.cancel();
+  if (lostPositions_.count(hash()) > 0) {
+    setDeadEnd(true);
+    return;
+  }
+  setDeadEnd(false);
+
+  // A winning hint plan already proves the position is not lost
+  auto cached = hintCache_.find(hash());
+  if (cached != hintCache_.end() && cached->second.outcome == WINNABLE) {
+    return;
+  }
+  deadEndEngine_.request(
+      board_, hardMode_ ? 3 : 1, deadEndDeadline_,
+      [this](const HintResult& result) {
+        QMetaObject::invokeMethod(
+            this, [this, result]() { storeDeadEnd(result); },
+            Qt::QueuedConnection);
+      },
+      HintEngine::BACKGROUND);
+}
+
+void Game::storeDeadEnd(const HintResult& result) {
+  if (result.outcome != UNWINNABLE ||
+      result.drawCount != (hardMode_ ? 3 : 1)) {
+    return;
+  }
+  lostPositions_.insert(result.hash);
+  if (result.hash == hash()) {
+    setDeadEnd(true);
+  }
+}
+
+void Game::setDeadEnd(bool isDeadEnd) {
+  if (isDeadEnd == isDeadEnd_) {
+    return;
+  }
+  isDeadEnd_ = isDeadEnd;
+  if (isDeadEnd && !reachedDeadEnd_) {
+    reachedDeadEnd_ = true;
+    deadEndMoves_ = moves_;
+  }
+  emit deadEndChange(isDeadEnd);
+}
+
+void Game::cacheHint(const HintResult& result) {
+  if (hintCache_.size() >= maxHintCache) {
+    hintCache_.clear();
+  }
+  hintCache_[result.hash] = result;
+}
+
+void Game::loadCachedSolve() {
+  CachedSolve cached;
+  if (solverCache_ == nullptr ||
+      !solverCache_->find(dealId_, hardMode_ ? 3 : 1, cached)) {
+    return;
+  }
+  if (cached.outcome == UNWINNABLE) {
+    lostPositions_.insert(hash());
+    setDeadEnd(true);
+    return;
+  }
+  HintResult result;
+  result.hash = hash();
+  result.outcome = cached.outcome;
+  result.moves = cached.solution;
+  if (result.moves.size() > static_cast<size_t>(hintEngine_.getPlanLength())) {
+    result.moves.resize(hintEngine_.getPlanLength());
+  }
+  cacheHint(result);
+}
+
+Card* Game::moveCard(const BoardMove& move) const {
+  switch (move.type_) {
+    case DECK_TO_WASTE:
+      return deck_->getTopCard();
+    case RECYCLE_DECK:
+      return wastePile_->getTopCard();
+    default:
+      return getPile(move.fromPile_)->getCardFromBack(move.nofCards_ - 1);
+  }
+}
+
+void Game::cancelHint() {
+  hintPending_ = false;
+  hintWanted_ = false;
+  hintEngine_.cancel();
+}
+
 Card* Game::findHint() const {
   // Klondike to Target / Klondike
   for (auto& klondikePile : klondikePiles_) {
@@ -439,3 +762,56 @@ Pile* Game::findPile(const QPointF& scenePosition) const {
   }
   return nullptr;
 }
+
+Pile* Game::getPile(int index) const {
+  if (index == Board::deckIndex) {
+    return deck_;
+  } else if (index == Board::wasteIndex) {
+    return wastePile_;
+  } else if (Board::isKlondike(index)) {
+    return klondikePiles_[index - Board::firstKlondikeIndex];
+  } else if (Board::isTarget(index)) {
+    return targetPiles_[index - Board::firstTargetIndex];
+  }
+  return nullptr;
+}
+
+int Game::pileIndex(const Pile* pile) const {
+  for (int i = 0; i < Board::pileAm; i++) {
+    if (getPile(i) == pile) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void Game::syncPile(Pile* pile) {
+  int index = pileIndex(pile);
+  if (index < 0) {
+    return;
+  }
+  PileState state(board_.piles[index].getKind(), index);
+  for (size_t i = pile->getSize(); i > 0; i--) {
+    state.addCard(pile->getCardFromBack(i - 1)->getState());
+  }
+  board_.piles[index] = state;
+  moveGen_.update(board_, index);
+  if (index >= Board::firstTargetIndex) {
+    foundations_.setPile(index - Board::firstTargetIndex,
+                         board_.piles[index].getTopCard());
+  }
+}
+
+uint64_t Game::hash() const {
+  uint64_t hash = 0;
+  for (int i = 0; i < Board::pileAm; i++) {
+    hash ^= Board::placeHash(i, getPile(i)->getHash());
+  }
+  return hash;
+}
+
+MoveList Game::legalMoves() const {
+  MoveList moves;
+  moveGen_.generate(board_, hardMode_ ? 3 : 1, moves);
+  return moves;
+}
@@ -4,8 +4,15 @@
 #include <QObject>
 #include <QTimer>
 #include <deque>
+#include <unordered_map>
+#include <unordered_set>
 
 #include "deck.hpp"
+#include "engine/foundations.hpp"
+#include "engine/hintEngine.hpp"
+#include "engine/moveGenerator.hpp"
+#include "engine/rules.hpp"
+#include "engine/solverCache.hpp"
 #include "gui/gameSoundManager.hpp"
 #include "klondikePile.hpp"
 #include "settings.hpp"
@@ -13,26 +20,6 @@
 #include "targetPile.hpp"
 #include "wastePile.hpp"
 
-#define KLONDIKE_PILE_AM 7  ///< Number of Klondike piles in the game.
-#define TARGET_PILE_AM 4    ///< Number of target piles in the game.
-
-/**
- * @brief Enum representing different types of moves in the game.
- *
- * Each move type has an associated point value that impacts the player's score.
- */
-enum MoveType {
-  WASTE_TO_KLONDIKE,
-  WASTE_TO_TARGET,
-  KLONDIKE_TO_TARGET,
-  KLONDIKE_TO_KLONDIKE,
-  FLIP_KLONDIKE,
-  TARGET_TO_KLONDIKE,
-  DECK_TO_WASTE,
-  RECYCLE_DECK,
-  UNKNOWN
-};
-
 /**
  * @brief Struct representing a move in the game.
  */
@@ -42,14 +29,16 @@ struct Move {
   Pile* toPile_;        ///< Pointer to the pile to which the move is made.
   const int nofCards_;  ///< Number of cards involved in the move.
   const int pointChange_;
+  const bool chained_;  ///< Whether undo reverts it with the move before.
 
   Move(MoveType type, Pile* fromPile, Pile* toPile, int nofCards,
-       int pointChange)
+       int pointChange, bool chained = false)
       : type_(type),
         fromPile_(fromPile),
         toPile_(toPile),
         nofCards_(nofCards),
-        pointChange_(pointChange) {}
+        pointChange_(pointChange),
+        chained_(chained) {}
 };
 
 using namespace std;
@@ -62,24 +51,38 @@ class Game : public QObject {
   Q_OBJECT
  public:
   // Start table of move points.
-  static const int wToKPoints = 5;
-  static const int wToTPoints = 10;
-  static const int kToTPoints = 10;
-  static const int kToKPoints = 0;
-
-  static const int turnOverPoints = 5;
-  static const int tToKPoints = -15;
-  static const int dToWPoints = 0;
-  static const int recycleDeckPoints = -100;
+  static const int wToKPoints = MovePoints::wToKPoints;
+  static const int wToTPoints = MovePoints::wToTPoints;
+  static const int kToTPoints = MovePoints::kToTPoints;
+  static const int kToKPoints = MovePoints::kToKPoints;
+
+  static const int turnOverPoints = MovePoints::turnOverPoints;
+  static const int tToKPoints = MovePoints::tToKPoints;
+  static const int dToWPoints = MovePoints::dToWPoints;
+  static const int recycleDeckPoints = MovePoints::recycleDeckPoints;
   // End table of move Points.
 
+  static const int defaultHintDeadline = 50;  ///< Hint search time in ms.
+  static const size_t maxHintCache = 4096;    ///< Most hints kept at once.
+  static const int defaultDeadEndDeadline = 500;  ///< Dead end search in ms.
+  static const int finishMoveTime = 300;  ///< Auto-finish card flight in ms.
+  static const int finishStagger = 60;    ///< Delay between those cards in ms.
+
   /**
-   * @brief Constructs a Game object.
+   * @brief Constructs a Game object with a random deal.
    *
    * @param parent Pointer to the parent QObject (default is nullptr).
    */
   Game(QObject* parent = nullptr);
 
+  /**
+   * @brief Constructs a Game object dealing a given deal.
+   *
+   * @param dealNumber The deal, the same number always deals the same cards.
+   * @param parent Pointer to the parent QObject (default is nullptr).
+   */
+  explicit Game(uint64_t dealNumber, QObject* parent = nullptr);
+
   /**
    * @brief Destroys the Game object.
    */
@@ -135,6 +138,57 @@ class Game : public QObject {
    */
   const vector<TargetPile*>& getTPiles() const { return targetPiles_; }
 
+  /**
+   * @brief Get a pile by its index on the Board.
+   * @param index Pile index, see Board.
+   * @return Pointer to the pile, or nullptr if the index is out of range.
+   */
+  Pile* getPile(int index) const;
+
+  /**
+   * @brief Get the index of a pile on the Board.
+   * @param pile Pointer to one of the game's piles.
+   * @return Pile index, see Board, or -1 if the pile is not part of the game.
+   */
+  int pileIndex(const Pile* pile) const;
+
+  /**
+   * @brief Get the rules engine mirror of the table.
+   *
+   * The board is kept in sync as moves are logged and undone.
+   *
+   * @return Reference to the board.
+   */
+  const Board& getBoard() const { return board_; }
+
+  /**
+   * @brief Get the Zobrist hash of the current position.
+   *
+   * Each pile keeps the hash of its cards up to date as they move, so this
+   * only combines the pile hashes. It equals getBoard().hash().
+   *
+   * @return The hash of the cards on every pile, in order, and their face.
+   */
+  uint64_t hash() const;
+
+  /**
+   * @brief Lists all legal moves of the current position.
+   * @return The moves, with piles referred to by their index on the Board.
+   */
+  MoveList legalMoves() const;
+
+  /**
+   * @brief Get the number of the deal being played.
+   * @return The deal number the deck was shuffled with.
+   */
+  uint64_t getDealNumber() const { return dealNumber_; }
+
+  /**
+   * @brief Get the id of the order the deck was shuffled to.
+   * @return The id, for keying saved games and caches, see rankDeal.
+   */
+  const DealId& getDealId() const { return dealId_; }
+
   /**
    * @brief Get player points.
    * @return points.
@@ -148,7 +202,23 @@ class Game : public QObject {
   /**
    * @brief Toggles hard mode for the game.
    */
-  void toggleHardMode() { hardMode_ = !hardMode_; }
+  void toggleHardMode();
+
+  /**
+   * @brief Turn automatic play of safe cards to the target piles on or off.
+   *
+   * When on, every move is followed by the cards no Klondike card can need
+   * any more, see Foundations. They are logged with the move, so undo takes
+   * them back together.
+   *
+   * @param autoPlay True to play safe cards automatically.
+   */
+  void setAutoPlay(bool autoPlay) { autoPlay_ = autoPlay; }
+
+  /**
+   * @brief Check whether safe cards are played automatically.
+   */
+  bool isAutoPlay() const { return autoPlay_; }
 
   /**
    * @brief Finds the first legal pile for a card to be moved to.
@@ -190,9 +260,30 @@ class Game : public QObject {
 
   /**
    * @brief undos the moves in history.
+   *
+   * Moves chained to the last move, such as the flip it caused or an
+   * auto-finish batch, are undone with it.
    */
   void undo();
 
+  /**
+   * @brief Checks if the rest of the game plays itself.
+   *
+   * That is when the deck and waste pile are empty and every card on the
+   * Klondike piles is face up.
+   *
+   * @return True if every remaining card can go to the target piles in order.
+   */
+  bool canAutoFinish() const;
+
+  /**
+   * @brief Moves every remaining card to the target piles at once.
+   *
+   * The moves are logged as one batch, undone together, and animated as a
+   * single staggered flight of cards.
+   */
+  void autoFinish();
+
   /**
    * @brief Determines the type of move between two piles.
    *
@@ -208,10 +299,78 @@ class Game : public QObject {
    */
   bool hasWon() const;
 
+  /**
+   * @brief Shows a hint by making a card and its destination glow.
+   *
+   * Hints are searched for on a background thread after every move, so the
+   * hint is usually cached already. Otherwise this returns right away and the
+   * card glows once the search ends, unless a move or undo happened in the
+   * meantime.
+   */
   void hint();
 
+  /**
+   * @brief Get the hint plan of the current position, if it is known.
+   * @return The first moves of the line the solver found, best move first,
+   * with piles referred to by their index on the Board. Empty while the hint
+   * is being searched for.
+   */
+  vector<BoardMove> getHintPlan() const;
+
   Card* findHint() const;
 
+  /**
+   * @brief Set how long the hint search may take.
+   * @param deadline Search time in milliseconds, when it runs out the best
+   * move found so far is shown.
+   */
+  void setHintDeadline(int deadline) { hintDeadline_ = deadline; }
+
+  /**
+   * @brief Get how long the hint search may take.
+   * @return Search time in milliseconds.
+   */
+  int getHintDeadline() const { return hintDeadline_; }
+
+  /**
+   * @brief Set the cache of solved deals to read when the game starts.
+   *
+   * A cached result gives the first hint plan, or the dead end, without
+   * searching. Call before startGame.
+   *
+   * @param cache The cache, which must outlive the game, or nullptr for none.
+   */
+  void setSolverCache(const SolverCache* cache) { solverCache_ = cache; }
+
+  /**
+   * @brief Set the difficulty of the deal, recorded in the stats.
+   * @param difficulty Score from 0 to 100, see difficultyScore.
+   */
+  void setDifficulty(double difficulty) { difficulty_ = difficulty; }
+
+  /**
+   * @brief Get the difficulty of the deal.
+   * @return Score from 0 to 100, or a negative number if not rated yet.
+   */
+  double getDifficulty() const { return difficulty_; }
+
+  /**
+   * @brief Check whether the current position is proven lost.
+   *
+   * After every move a bounded search runs in the background, see
+   * deadEndChange.
+   *
+   * @return True if no sequence of moves wins from here, otherwise false.
+   */
+  bool isDeadEnd() const { return isDeadEnd_; }
+
+  /**
+   * @brief Set how long the dead end search may take.
+   * @param deadline Search time in milliseconds, the position counts as
+   * winnable if the search does not finish in time.
+   */
+  void setDeadEndDeadline(int deadline) { deadEndDeadline_ = deadline; }
+
   /**
    * @brief Updates game stats into file
    */
@@ -222,6 +381,13 @@ class Game : public QObject {
   void gameStateChange(const unsigned int points, const unsigned int moves);
   void gameWon(const unsigned int _t1);
 
+  /**
+   * @brief Emitted when the current position becomes proven lost, or stops
+   * being lost after an undo.
+   * @param isDeadEnd True if the position is proven lost.
+   */
+  void deadEndChange(const bool isDeadEnd);
+
  private slots:
 
   /**
@@ -248,11 +414,118 @@ class Game : public QObject {
   void handleAutoMove(Card* card, Pile* fromPile);
 
  private:
+  /**
+   * @brief Copy a pile into the board mirror and refresh its move indices.
+   * @param pile Pointer to the pile that changed.
+   */
+  void syncPile(Pile* pile);
+
+  /**
+   * @brief Flip the card a move uncovered on a Klondike pile, if any.
+   *
+   * The flip is logged chained to the move.
+   *
+   * @param move The move that was executed.
+   */
+  void logFlip(const Move& move);
+
+  /**
+   * @brief Play every safe card on top of the waste and Klondike piles to
+   * the target piles, logged chained to the move before.
+   */
+  void autoPlaySafeCards();
+
+  /**
+   * @brief Revert a single move from history.
+   * @param move The move, already removed from history.
+   */
+  void undoMove(const Move& move);
+
+  /**
+   * @brief Start searching for the hint of the current position.
+   *
+   * Does nothing if the hint is cached or already being searched for.
+   *
+   * @param priority BACKGROUND when no hint was asked for yet.
+   */
+  void requestHint(HintEngine::Priority priority);
+
+  /**
+   * @brief Cache the result of a finished hint search.
+   *
+   * Shows it if the player asked for the hint of the current position.
+   *
+   * @param result The hint for the position it was requested for.
+   */
+  void storeHint(const HintResult& result);
+
+  /**
+   * @brief Make the card of a hint and its destination glow.
+   * @param result The hint for the current position.
+   */
+  void showHint(const HintResult& result);
+
+  /**
+   * @brief Reuse the plan of the previous position if a move followed it.
+   *
+   * The rest of the plan is cached as the hint of the current position, so
+   * following a plan never searches again until it runs out.
+   *
+   * @param previousHash Hash of the position before the move.
+   * @param move The move that was played.
+   */
+  void followHintPlan(uint64_t previousHash, const BoardMove& move);
+
+  /**
+   * @brief Start the dead end search of the current position.
+   *
+   * Positions proven lost before are not searched again.
+   */
+  void checkDeadEnd();
+
+  /**
+   * @brief Remember a position the solver proved lost.
+   * @param result A finished search, ignored unless it is UNWINNABLE.
+   */
+  void storeDeadEnd(const HintResult& result);
+
+  /**
+   * @brief Update whether the current position is a dead end.
+   * @param isDeadEnd True if the position is proven lost.
+   */
+  void setDeadEnd(bool isDeadEnd);
+
+  /**
+   * @brief Add a hint to the cache, emptying it first when it is full.
+   * @param result The hint for the position it was requested for.
+   */
+  void cacheHint(const HintResult& result);
+
+  /**
+   * @brief Take the hint plan or dead end of the deal from the solver cache.
+   */
+  void loadCachedSolve();
+
+  /**
+   * @brief Get the card a move would pick up.
+   * @param move The move, with piles referred to by their index on the Board.
+   * @return Pointer to the card, or nullptr if the move picks up none.
+   */
+  Card* moveCard(const BoardMove& move) const;
+
+  /**
+   * @brief Stop the hint search in flight, if any.
+   */
+  void cancelHint();
+
   Deck* deck_;                           ///< The deck of cards.
   WastePile* wastePile_;                 ///< The waste pile.
   vector<KlondikePile*> klondikePiles_;  ///< The Klondike piles.
   vector<TargetPile*> targetPiles_;      ///< The target piles.
 
+  uint64_t dealNumber_;  ///< The deal the deck was shuffled with.
+  DealId dealId_;        ///< Id of the shuffled order of the deck.
+
   QTimer* timer_;
   unsigned int elapsedTime_;
 
@@ -262,14 +535,32 @@ class Game : public QObject {
   unsigned int undos_;
 
   bool hardMode_;  ///< Indicates if the game is in hard mode.
+  bool autoPlay_;  ///< Whether safe cards are played automatically.
   bool hintsEnabled_;
   bool isWon_;  ///< Indicates if the game has been won.
   unsigned int
       maxHistory_;  ///< The maximium amount of moves stored in the history.
 
   deque<Move> movehistory_;        ///< Stack storing the history of moves.
+  Board board_;                    ///< Rules engine mirror of the piles.
+  MoveGenerator moveGen_;          ///< Legal move indices of board_.
+  Foundations foundations_;        ///< Target heights and safe cards.
   GameSoundManager soundManager_;  ///< Game sound manager.
   Card* prevHint_;
+  HintEngine hintEngine_;  ///< Searches for hints in the background.
+  int hintDeadline_;       ///< Hint search time in milliseconds.
+  bool hintPending_;       ///< Whether a hint search is in flight.
+  bool hintWanted_;        ///< Whether the player waits for the hint.
+  unordered_map<uint64_t, HintResult> hintCache_;  ///< Hints by position.
+  const SolverCache* solverCache_;                 ///< Solved deals, or null.
+
+  HintEngine deadEndEngine_;   ///< Searches for dead ends in the background.
+  int deadEndDeadline_;        ///< Dead end search time in milliseconds.
+  bool isDeadEnd_;             ///< Whether the position is proven lost.
+  bool reachedDeadEnd_;        ///< Whether any position was proven lost.
+  unsigned int deadEndMoves_;  ///< Moves made when the first dead end was hit.
+  unordered_set<uint64_t> lostPositions_;  ///< Hashes of proven lost positions.
+  double difficulty_;  ///< Difficulty score of the deal, negative if unknown.
 };
 
 #endif
@@ -10,10 +10,10 @@
 #include "klondikeLayout.hpp"
 #include "mainwindow.h"
 
-GameView::GameView(Settings &settings, QWidget *parent)
+GameView::GameView(Settings &settings, uint64_t dealNumber, QWidget *parent)
     : QGraphicsView(parent),
       scene_(new QGraphicsScene(this)),
-      game_(make_unique<Game>()) {
+      game_(make_unique<Game>(dealNumber)) {
   initView();
   initButtons();
   initLabels();
@@ -109,13 +109,23 @@ void GameView::initLabels() {
   pointsLabel_ = new QLabel("Points: 0");
   moveLabel_ = new QLabel("Moves: 0");
   timerLabel_ = new QLabel("0:00:00");
+  dealLabel_ = new QLabel(QString("Deal #%1").arg(game_->getDealNumber()));
   pointsLabel_->setStyleSheet("color: white;");
   moveLabel_->setStyleSheet("color: white;");
   timerLabel_->setStyleSheet("color: white;");
+  dealLabel_->setStyleSheet("color: white;");
+  dealLabel_->setTextInteractionFlags(Qt::TextSelectableByMouse);
+  deadEndLabel_ = new QLabel("No winning moves left");
+  deadEndLabel_->setStyleSheet("color: #FFD54F; font-weight: bold;");
+  deadEndLabel_->setVisible(game_->isDeadEnd());
+  difficultyLabel_ = new QLabel("Difficulty: ...");
+  difficultyLabel_->setStyleSheet("color: white;");
 
   connect(game_.get(), &Game::gameStateChange, this,
           &GameView::handleGameStateChange);
   connect(game_.get(), &Game::updateTime, this, &GameView::handleTimeElapsed);
+  connect(game_.get(), &Game::deadEndChange, this,
+          &GameView::handleDeadEndChange);
 }
 
 void GameView::initToolbar() {
@@ -130,6 +140,9 @@ void GameView::initToolbar() {
   toolbarLayout->addWidget(undoButton_);
   toolbarLayout->addWidget(hintButton_);
   toolbarLayout->addStretch();
+  toolbarLayout->addWidget(deadEndLabel_);
+  toolbarLayout->addWidget(dealLabel_);
+  toolbarLayout->addWidget(difficultyLabel_);
   toolbarLayout->addWidget(timerLabel_);
   toolbarLayout->addWidget(pointsLabel_);
   toolbarLayout->addWidget(moveLabel_);
@@ -186,3 +199,17 @@ void GameView::handleTimeElapsed(const unsigned int elapsedTime) {
   QString newText = MainWindow::formatTime(elapsedTime);
   timerLabel_->setText(newText);
 }
+
+void GameView::handleDeadEndChange(const bool isDeadEnd) {
+  deadEndLabel_->setVisible(isDeadEnd);
+}
+
+void GameView::setDifficulty(const DifficultyRating &rating) {
+  game_->setDifficulty(rating.score);
+  if (rating.outcome == UNWINNABLE) {
+    difficultyLabel_->setText("Difficulty: unwinnable");
+  } else {
+    difficultyLabel_->setText(
+        QString("Difficulty: %1").arg(qRound(rating.score)));
+  }
+}
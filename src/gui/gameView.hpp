@@ -8,6 +8,7 @@
 #include <QToolButton>
 #include <memory>
 
+#include "engine/difficulty.hpp"
 #include "game.hpp"
 #include "layout.hpp"
 #include "settings.hpp"
@@ -34,9 +35,10 @@ class GameView : public QGraphicsView {
    * Initializes the view with the given settings and parent widget.
    *
    * @param settings The settings to be applied to the game and game view.
+   * @param dealNumber The deal to play, see Game::getDealNumber.
    * @param parent The parent widget for the view (default is nullptr).
    */
-  GameView(Settings &settings, QWidget *parent = nullptr);
+  GameView(Settings &settings, uint64_t dealNumber, QWidget *parent = nullptr);
 
   /**
    * @brief Default destructor for the GameView object.
@@ -57,6 +59,29 @@ class GameView : public QGraphicsView {
    */
   void startGame() { game_->startGame(); }
 
+  /**
+   * @brief Gets the number of the deal being played.
+   *
+   * @return The deal number, which deals the same cards when played again.
+   */
+  uint64_t getDealNumber() const { return game_->getDealNumber(); }
+
+  /**
+   * @brief Sets the cache of solved deals the game reads when it starts.
+   *
+   * @param cache The cache, see Game::setSolverCache.
+   */
+  void setSolverCache(const SolverCache *cache) {
+    game_->setSolverCache(cache);
+  }
+
+  /**
+   * @brief Shows the difficulty of the deal and keeps it for the stats.
+   *
+   * @param rating The rating of the deal, see DifficultyRater.
+   */
+  void setDifficulty(const DifficultyRating &rating);
+
   /**
    * @brief Changes the settings of the game and game view.
    *
@@ -103,6 +128,13 @@ class GameView : public QGraphicsView {
    */
   void handleTimeElapsed(const unsigned int elapsedTime);
 
+  /**
+   * @brief Slot to show or hide the dead end notice.
+   *
+   * @param isDeadEnd True if the current position is proven lost.
+   */
+  void handleDeadEndChange(const bool isDeadEnd);
+
  private:
   QGraphicsScene *scene_;       ///< The scene containing all graphical items
   std::unique_ptr<Game> game_;  ///< The game logic handling the Solitaire game
@@ -111,9 +143,12 @@ class GameView : public QGraphicsView {
 
   QWidget
       *toolbarWidget_;   ///< The toolbar widget containing buttons and labels
-  QLabel *pointsLabel_;  ///< The label displaying the player's points
-  QLabel *moveLabel_;    ///< The label displaying the number of moves made
-  QLabel *timerLabel_;   ///< The label displaying the elapsed time
+  QLabel *pointsLabel_;   ///< The label displaying the player's points
+  QLabel *moveLabel_;     ///< The label displaying the number of moves made
+  QLabel *timerLabel_;    ///< The label displaying the elapsed time
+  QLabel *dealLabel_;     ///< The label displaying the deal number
+  QLabel *deadEndLabel_;  ///< The label telling the game can't be won
+  QLabel *difficultyLabel_;  ///< The label displaying the deal's difficulty
 
   QPushButton *hintButton_;  ///< Button to provide a hint to the player
   QPushButton *undoButton_;  ///< Button to undo the last move
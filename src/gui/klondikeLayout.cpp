@@ -1,5 +1,7 @@
 #include "klondikeLayout.hpp"
 
+#include "cardImages.hpp"
+
 KlondikeLayout::KlondikeLayout(QGraphicsScene* scene, Game* game)
     : Layout(scene, game) {
   init();
@@ -90,6 +92,11 @@ void KlondikeLayout::resize(const QSizeF& newSize) {
     yDiff = pHeight * vertFactor;
   }
 
+  // Have the card images scaled once for the size they are now shown at
+  const QList<QGraphicsView*> views = scene->views();
+  const qreal dpr = views.isEmpty() ? 1.0 : views.first()->devicePixelRatioF();
+  CardImages::setRenditionScale(SCALING_FACTOR * scale, dpr);
+
   // Begin scaling and position changes.
   deck->setScale(scale);
   wPile->setScale(scale);
@@ -1,5 +1,8 @@
 #include "mainwindow.h"
 
+#include <fstream>
+
+#include "cardImages.hpp"
 #include "game.hpp"
 #include "stats.hpp"
 #include "ui_mainwindow.h"
@@ -8,7 +11,11 @@ MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
       ui(new Ui::MainWindow),
       gameView_(nullptr),
-      gameStarted_(false) {
+      gameStarted_(false),
+      dealGenerator_(&solverCache_),
+      difficultyRater_(2, DifficultyRater::defaultLimits(),
+                       DifficultyRater::defaultPlayouts,
+                       DifficultyRater::defaultQueueSize, &solverCache_) {
   ui->setupUi(this);
 
   ui->menuGame->menuAction()->setVisible(
@@ -24,7 +31,7 @@ MainWindow::MainWindow(QWidget *parent)
           &MainWindow::fullscreen);
   connect(ui->actionQuit, &QAction::triggered, this, &QApplication::quit);
   connect(ui->actionNew_Game, &QAction::triggered, this,
-          &MainWindow::startGame);
+          qOverload<>(&MainWindow::startGame));
 
   // Main menu button connections
 
@@ -32,7 +39,7 @@ MainWindow::MainWindow(QWidget *parent)
           &MainWindow::continueGame);
 
   connect(ui->startGameButton, &QPushButton::clicked, this,
-          &MainWindow::startGame);
+          qOverload<>(&MainWindow::startGame));
 
   connect(ui->settingsButton, &QPushButton::clicked, this,
           &MainWindow::openSettings);
@@ -53,8 +60,15 @@ MainWindow::MainWindow(QWidget *parent)
   connect(ui->statsToMenuButton, &QPushButton::clicked, this,
           &MainWindow::toMenu);
 
+  solverCache_.open("solver.cache");
+  CardImages::setCacheDir("renditions");
+  // Ratings computed offline by solitaire_analyze, or in earlier sessions
+  std::ifstream ratings("ratings.csv");
+  if (ratings) {
+    difficultyRater_.load(ratings);
+  }
   loadSettings();
-  initNewGame();
+  initNewGame(nextDealNumber());
 }
 
 void MainWindow::loadSettings() {
@@ -65,22 +79,45 @@ void MainWindow::loadSettings() {
     gameSettings_.volume = 50;
     gameSettings_.isHardModeEnabled = false;
     gameSettings_.isHintsEnabled = true;
+    gameSettings_.isAutoPlayEnabled = false;
+    gameSettings_.isWinnableOnly = false;
     saveSettingsToJSON(gameSettings_, filepath);
   }
   ui->hardModeCheckbox->setChecked(gameSettings_.isHardModeEnabled);
   ui->hintsCheckbox->setChecked(gameSettings_.isHintsEnabled);
+  ui->autoPlayCheckbox->setChecked(gameSettings_.isAutoPlayEnabled);
+  ui->winnableOnlyCheckbox->setChecked(gameSettings_.isWinnableOnly);
   ui->volumeSlider->setValue(gameSettings_.volume);
+  updateDealGenerator();
 }
 
 void MainWindow::saveSettings() {
   gameSettings_.isHardModeEnabled = ui->hardModeCheckbox->isChecked();
   gameSettings_.isHintsEnabled = ui->hintsCheckbox->isChecked();
+  gameSettings_.isAutoPlayEnabled = ui->autoPlayCheckbox->isChecked();
+  gameSettings_.isWinnableOnly = ui->winnableOnlyCheckbox->isChecked();
   gameSettings_.volume = ui->volumeSlider->value();
 
   QString filepath("settings.json");
   saveSettingsToJSON(gameSettings_, filepath);
 
   if (gameView_) gameView_->changeSettings(gameSettings_);
+  updateDealGenerator();
+}
+
+void MainWindow::updateDealGenerator() {
+  if (gameSettings_.isWinnableOnly) {
+    dealGenerator_.start(gameSettings_.isHardModeEnabled ? 3 : 1);
+  } else {
+    dealGenerator_.stop();
+  }
+}
+
+uint64_t MainWindow::nextDealNumber() {
+  if (gameSettings_.isWinnableOnly) {
+    return dealGenerator_.next();
+  }
+  return randomDealNumber();
 }
 
 void MainWindow::fullscreen() {
@@ -113,7 +150,7 @@ void MainWindow::returnToPrev() { switchToPage(previousWindow_); }
 
 void MainWindow::backToMenuInit() {
   toMenu();
-  initNewGame();
+  initNewGame(nextDealNumber());
   ui->continueButton->setEnabled(false);
 }
 
@@ -150,9 +187,21 @@ void MainWindow::toStatistics() {
 }
 
 void MainWindow::startGame() {
-  // If a game is currently running or no game has been initialized
-  // Reinitialize the game and start it
-  if (gameStarted() || !gameInitialized()) initNewGame();
+  // Play the deal set up in the game view, unless it is already being played
+  if (gameStarted() || !gameInitialized()) {
+    startGame(nextDealNumber());
+  } else {
+    startGame(gameView_->getDealNumber());
+  }
+}
+
+void MainWindow::startGame(uint64_t dealNumber) {
+  // If a game is currently running, no game has been initialized or the
+  // initialized game has another deal, reinitialize the game and start it
+  if (gameStarted() || !gameInitialized() ||
+      gameView_->getDealNumber() != dealNumber) {
+    initNewGame(dealNumber);
+  }
 
   gameView_->updateLayout(this->size());
   setGameStarted(true);
@@ -181,18 +230,37 @@ void MainWindow::deleteGame() {
   }
 }
 
-void MainWindow::initNewGame() {
+void MainWindow::initNewGame(uint64_t dealNumber) {
   // Delete old game
   deleteGame();
 
   // Init a new one
-  gameView_ = new GameView(gameSettings_, this);
+  gameView_ = new GameView(gameSettings_, dealNumber, this);
+  gameView_->setSolverCache(solverCache_.isOpen() ? &solverCache_ : nullptr);
   connect(gameView_, &GameView::gameWon, this, &MainWindow::onGameWon);
   connect(gameView_, &GameView::dropdownSignal, this,
           &MainWindow::fromDropdownSlot);
 
   // Insert the new GameView into the stacked widget
   stackedWidget_->insertWidget(GAME, gameView_);
+  rateDeal();
+}
+
+void MainWindow::rateDeal() {
+  const uint64_t dealNumber = gameView_->getDealNumber();
+  // The rating is ready on a pool thread, show it from the event loop
+  difficultyRater_.request(
+      dealNumber, gameSettings_.isHardModeEnabled ? 3 : 1,
+      [this, dealNumber](const DifficultyRating &rating) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, dealNumber, rating]() {
+              if (gameView_ && gameView_->getDealNumber() == dealNumber) {
+                gameView_->setDifficulty(rating);
+              }
+            },
+            Qt::QueuedConnection);
+      });
 }
 
 void MainWindow::onGameWon(const unsigned int points) {
@@ -202,7 +270,15 @@ void MainWindow::onGameWon(const unsigned int points) {
 
 void MainWindow::quit() { this->close(); }
 
-MainWindow::~MainWindow() { delete ui; }
+MainWindow::~MainWindow() {
+  // Keep the card images at the size the window was left at
+  CardImages::saveCache();
+  // Ratings cut short are dropped, and no callback reaches this any more
+  difficultyRater_.stop();
+  std::ofstream ratings("ratings.csv");
+  difficultyRater_.save(ratings);
+  delete ui;
+}
 
 void MainWindow::fromDropdownSlot(DropDownOption option) {
   switch (option) {
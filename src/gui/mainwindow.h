@@ -5,6 +5,10 @@
 #include <QResizeEvent>
 #include <QStackedWidget>
 
+#include "engine/deal.hpp"
+#include "engine/dealGenerator.hpp"
+#include "engine/difficulty.hpp"
+#include "engine/solverCache.hpp"
 #include "gameView.hpp"
 #include "settings.hpp"
 
@@ -90,9 +94,19 @@ class MainWindow : public QMainWindow {
 
   /**
    * @brief Starts a new game.
+   *
+   * Plays the deal already set up in the game view, or a random deal if a
+   * game is running.
    */
   void startGame();
 
+  /**
+   * @brief Starts a new game with a given deal.
+   *
+   * @param dealNumber The deal to play, the same number deals the same cards.
+   */
+  void startGame(uint64_t dealNumber);
+
   /**
    * @brief Continues an ongoing game.
    */
@@ -105,8 +119,33 @@ class MainWindow : public QMainWindow {
 
   /**
    * @brief Initializes a new game setup.
+   *
+   * @param dealNumber The deal to set up, see nextDealNumber.
+   */
+  void initNewGame(uint64_t dealNumber);
+
+  /**
+   * @brief Shows the difficulty of the game's deal, rating it in the
+   * background if it has not been rated yet.
+   */
+  void rateDeal();
+
+  /**
+   * @brief Picks the deal of a new game without waiting.
+   *
+   * With winnable deals only, a deal solved in the background is taken. If
+   * none is ready yet, such as at launch, one of the generator's built-in
+   * winnable deals is dealt instead, so the deal is always proven winnable.
+   *
+   * @return The deal number.
+   */
+  uint64_t nextDealNumber();
+
+  /**
+   * @brief Starts or stops solving deals in the background, following the
+   * settings.
    */
-  void initNewGame();
+  void updateDealGenerator();
 
   /**
    * @brief Checks if a game has been initialized.
@@ -146,6 +185,9 @@ class MainWindow : public QMainWindow {
   Window
       previousWindow_;  ///< Keeps track of the previous window for navigation
   bool gameStarted_;    ///< Flag to track whether a game is running
+  SolverCache solverCache_;  ///< Solved deals shared with the analysis tool
+  DealGenerator dealGenerator_;  ///< Winnable deals solved in the background
+  DifficultyRater difficultyRater_;  ///< Rates deals in the background
 
   /**
    * @brief Switches the main window to a specific page.
@@ -11,10 +11,7 @@ bool KlondikePile::isValid(const Card& card) {
   if (this->isEmpty()) {
     return card.getRank() == Rank::KING;
   }
-  Card* top = getTopCard();
-  bool diffColor = card.getColor() != top->getColor();
-  bool isNextLower = card.getRank() == top->getRank() - 1;
-  return diffColor && isNextLower;
+  return canStackOnKlondike(card.getIndex(), getTopCard()->getIndex());
 }
 
 // GUI RELATED FUNCTIONS
@@ -1,8 +1,35 @@
 #include <QApplication>
 #include <QDebug>
 #include <QDirIterator>
+#include <QElapsedTimer>
 
 #include "gui/mainwindow.h"
+
+/**
+ * @brief Logs the time from startup to the first paint of any widget, then
+ * removes itself.
+ */
+class FirstFrameLogger : public QObject {
+ public:
+  /**
+   * @brief Construct the logger.
+   * @param startup Timer started when the process started.
+   */
+  explicit FirstFrameLogger(const QElapsedTimer &startup)
+      : startup_(startup) {}
+
+  bool eventFilter(QObject *watched, QEvent *event) override {
+    Q_UNUSED(watched);
+    if (event->type() == QEvent::Paint) {
+      qDebug() << "First frame after" << startup_.elapsed() << "ms";
+      qApp->removeEventFilter(this);
+    }
+    return false;
+  }
+
+ private:
+  const QElapsedTimer &startup_;  ///< Started when the process started.
+};
 /**
  * @brief main function
  * @param argc Argument count
@@ -11,10 +38,17 @@
  */
 
 int main(int argc, char *argv[]) {
+  QElapsedTimer startup;
+  startup.start();
+
   // creates a stat file
   createInitialStatsFile("stats.csv");
   QApplication app(argc, argv);
 
+  // Seen before the first widget paints, whichever that is
+  FirstFrameLogger firstFrame(startup);
+  app.installEventFilter(&firstFrame);
+
   MainWindow mainWindow;
   mainWindow.show();
 
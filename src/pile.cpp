@@ -1,10 +1,18 @@
 #include "pile.hpp"
 
 #include <QDebug>
+#include <QTimer>
 #include <stack>
 
+#include "engine/board.hpp"
+#include "engine/zobrist.hpp"
+
 Pile::Pile(QGraphicsItem* parent)
-    : QGraphicsObject(parent), rect_(0, 0, 100, 150) {}
+    : QGraphicsObject(parent),
+      hash_(0),
+      index_(0),
+      rect_(0, 0, 100, 150),
+      isHighlighted_(false) {}
 
 Pile::~Pile() { qDebug() << "PILE destroyed"; }
 
@@ -17,7 +25,16 @@ Card* Pile::getTopCard() const {
   return nullptr;
 }
 
+void Pile::setIndex(int index) {
+  index_ = index;
+  hash_ = 0;
+  for (size_t i = 0; i < cards_.size(); i++) {
+    hash_ ^= zobristKey(Board::pileKind(index_), i, cards_[i]->getState());
+  }
+}
+
 void Pile::addCard(Card* card) {
+  hash_ ^= zobristKey(Board::pileKind(index_), cards_.size(), card->getState());
   card->setParentItem(this);
   connect(card, &Card::cardClicked, this, &Pile::onCardClicked);
   connect(card, &Card::cardDragged, this, &Pile::onCardDragged);
@@ -33,6 +50,7 @@ Card* Pile::removeCard() {
   disconnect(card, &Card::cardClicked, this, &Pile::onCardClicked);
   disconnect(card, &Card::cardDragged, this, &Pile::onCardDragged);
   cards_.pop_back();
+  hash_ ^= zobristKey(Board::pileKind(index_), cards_.size(), card->getState());
   return card;
 }
 
@@ -86,21 +104,17 @@ bool Pile::flipTopCard(bool faceUp, const int indexFromBack) {
   }
 
   int size = this->getSize();
+  int depth = size - indexFromBack;
 
-  Card* card = cards_[size - indexFromBack];
-
-  if (faceUp) {
-    if (!card->isFaceUp()) {
-      card->flip();  // Flip to face-up
-      return true;   // Successfully flipped
-    }
-  } else {
-    if (card->isFaceUp()) {
-      card->flip();  // Flip to face-down
-    }
+  Card* card = cards_[depth];
+  if (card->isFaceUp() == faceUp) {
+    return false;  // No action taken
   }
 
-  return false;  // No action taken
+  hash_ ^= zobristKey(Board::pileKind(index_), depth, card->getState());
+  card->flip();
+  hash_ ^= zobristKey(Board::pileKind(index_), depth, card->getState());
+  return faceUp;  // Successfully flipped up
 }
 
 int Pile::cardIndexFromTop(Card* card) const {
@@ -125,10 +139,24 @@ void Pile::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
   Q_UNUSED(option);
   Q_UNUSED(widget);
   painter->setBrush(Qt::transparent);
-  painter->setPen(Qt::darkGreen);
+  painter->setPen(isHighlighted_ ? Qt::darkRed : Qt::darkGreen);
   painter->drawRect(rect_);
 }
 
+void Pile::highlight() {
+  Card* topCard = getTopCard();
+  if (topCard != nullptr) {
+    topCard->animateGlow();
+    return;
+  }
+  isHighlighted_ = true;
+  update();
+  QTimer::singleShot(highlightTime, this, [this]() {
+    isHighlighted_ = false;
+    update();
+  });
+}
+
 void Pile::onCardClicked(Card* card) { emit cardClickMove(card, this); }
 void Pile::onCardDragged(Card* card, const QPointF& newScenePos) {
   emit cardMoved(card, this, newScenePos);
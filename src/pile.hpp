@@ -42,6 +42,27 @@ class Pile : public QGraphicsObject {
    */
   size_t getSize() const { return cards_.size(); }
 
+  /**
+   * @brief Get the Zobrist hash of the cards in the pile.
+   *
+   * Kept up to date as cards are added, removed and flipped through the pile,
+   * so cards must not be flipped directly with Card::flip.
+   *
+   * @return The same value as PileState::getHash for the same cards.
+   */
+  uint64_t getHash() const { return hash_; }
+
+  /**
+   * @brief Get the index of the pile on the table, see Board.
+   */
+  int getIndex() const { return index_; }
+
+  /**
+   * @brief Set the index of the pile on the table and rehash its cards.
+   * @param index Pile index, see Board.
+   */
+  void setIndex(int index);
+
   /**
    * @brief Check whether the pile container is empty.
    * @return true if the pile is empty, false otherwise.
@@ -144,6 +165,14 @@ class Pile : public QGraphicsObject {
    */
   virtual QPointF getOffset() const = 0;
 
+  /**
+   * @brief Draw attention to the pile, for example as the destination of a
+   * hint.
+   *
+   * Makes the top card glow, or outlines the empty slot for a while.
+   */
+  void highlight();
+
  signals:
   /**
    * @brief Signal emitted when a card is moved.
@@ -169,6 +198,8 @@ class Pile : public QGraphicsObject {
    */
 
   vector<Card*> cards_;  ///< All the cards inside this pile.
+  uint64_t hash_;        ///< Zobrist hash of the cards.
+  int index_;            ///< Index of the pile on the table.
 
   /**
    * @brief Add a card to the pile.
@@ -183,7 +214,10 @@ class Pile : public QGraphicsObject {
    * @{
    */
 
-  const QRectF rect_;  ///< The rectangle defining the item’s graphical size.
+  static const int highlightTime = 1500;  ///< Outline time in ms.
+
+  const QRectF rect_;   ///< The rectangle defining the item’s graphical size.
+  bool isHighlighted_;  ///< Whether the empty slot is outlined.
 
   /**
    * @brief Return the bounding rectangle of the item. Defines the area within
@@ -8,6 +8,8 @@ QJsonObject Settings::toJson() const {
   json["volume"] = volume;
   json["hints"] = isHintsEnabled;
   json["hardmode"] = isHardModeEnabled;
+  json["autoplay"] = isAutoPlayEnabled;
+  json["winnable"] = isWinnableOnly;
   return json;
 }
 
@@ -19,6 +21,10 @@ void Settings::fromJson(const QJsonObject& json) {
     isHintsEnabled = json["hints"].toBool();
   if (json.contains("hardmode") && json["hardmode"].isBool())
     isHardModeEnabled = json["hardmode"].toBool();
+  if (json.contains("autoplay") && json["autoplay"].isBool())
+    isAutoPlayEnabled = json["autoplay"].toBool();
+  if (json.contains("winnable") && json["winnable"].isBool())
+    isWinnableOnly = json["winnable"].toBool();
 }
 
 // Function to save settings to a JSON file
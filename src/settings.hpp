@@ -15,9 +15,11 @@
  * easy saving and loading.
  */
 struct Settings {
-  int volume;              ///< The volume level for the game (0-100)
-  bool isHintsEnabled;     ///< Whether hints are enabled (true if enabled)
-  bool isHardModeEnabled;  ///< Whether hard mode is enabled (true if enabled)
+  int volume;                      ///< The volume level for the game (0-100)
+  bool isHintsEnabled;             ///< Whether hints are enabled
+  bool isHardModeEnabled;          ///< Whether hard mode is enabled
+  bool isAutoPlayEnabled = false;  ///< Whether safe cards go up on their own
+  bool isWinnableOnly = false;     ///< Whether only winnable deals are dealt
 
   /**
    * @brief Converts the settings to a JSON object.
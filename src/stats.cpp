@@ -15,8 +15,9 @@ void createInitialStatsFile(const std::string& fileName) {
       // Write the header and initial values
       file << "Games,Wins,Losses,WinRate,TotalTime,BestTime,AvgTime,TotalMoves,"
               "BestMoves,AvgMoves,UndoCount,HintCount,TotalPoints,BestPoints,"
-              "AvgPoints\n";
-      file << "0,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n ";
+              "AvgPoints,DeadEnds,DeadEndMoves,RatedGames,TotalDifficulty,"
+              "RatedWins,WonDifficulty\n";
+      file << "0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n ";
 
       file.close();
       std::cout << "Initial stats file created: " << fileName << std::endl;
@@ -33,7 +34,8 @@ void saveStatsToCSV(const std::string& fileName, const GameStats& stats) {
     // Write header row
     file << "Games,Wins,Losses,WinRate,TotalTime,BestTime,AvgTime,TotalMoves,"
             "BestMoves,AvgMoves,UndoCount,HintCount,TotalPoints,BestPoints,"
-            "AvgPoints\n";
+            "AvgPoints,DeadEnds,DeadEndMoves,RatedGames,TotalDifficulty,"
+            "RatedWins,WonDifficulty\n";
 
     // Write each record
     file << stats.games << "," << stats.wins << "," << stats.losses << ","
@@ -41,7 +43,10 @@ void saveStatsToCSV(const std::string& fileName, const GameStats& stats) {
          << "," << stats.avgTime << "," << stats.totalMoves << ","
          << stats.bestMoves << "," << stats.avgMoves << "," << stats.undoCount
          << "," << stats.hintCount << "," << stats.totalPoints << ","
-         << stats.bestPoints << "," << stats.avgPoints << "\n";
+         << stats.bestPoints << "," << stats.avgPoints << ","
+         << stats.deadEnds << "," << stats.deadEndMoves << ","
+         << stats.ratedGames << "," << stats.totalDifficulty << ","
+         << stats.ratedWins << "," << stats.wonDifficulty << "\n";
 
     file.close();
   } else {
@@ -98,6 +103,34 @@ GameStats fromCSV(const std::string& fileName) {
       stats.bestPoints = std::stoul(cell);
       std::getline(lineStream, cell, ',');
       stats.avgPoints = std::stod(cell);
+
+      // Files written before dead ends were tracked end here
+      stats.deadEnds = 0;
+      stats.deadEndMoves = 0;
+      if (std::getline(lineStream, cell, ',')) {
+        stats.deadEnds = std::stoul(cell);
+      }
+      if (std::getline(lineStream, cell, ',')) {
+        stats.deadEndMoves = std::stoul(cell);
+      }
+
+      // And here before deals were rated
+      stats.ratedGames = 0;
+      stats.totalDifficulty = 0;
+      stats.ratedWins = 0;
+      stats.wonDifficulty = 0;
+      if (std::getline(lineStream, cell, ',')) {
+        stats.ratedGames = std::stoul(cell);
+      }
+      if (std::getline(lineStream, cell, ',')) {
+        stats.totalDifficulty = std::stod(cell);
+      }
+      if (std::getline(lineStream, cell, ',')) {
+        stats.ratedWins = std::stoul(cell);
+      }
+      if (std::getline(lineStream, cell, ',')) {
+        stats.wonDifficulty = std::stod(cell);
+      }
     }
 
     file.close();
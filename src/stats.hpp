@@ -36,6 +36,14 @@ struct GameStats {
   unsigned long totalPoints;  ///< Total points scored across all games
   unsigned int bestPoints;    ///< Highest points scored in a single game
   double avgPoints;           ///< Average points scored per game
+
+  unsigned int deadEnds;       ///< Games that reached a position proven lost
+  unsigned long deadEndMoves;  ///< Moves made after reaching a dead end
+
+  unsigned int ratedGames;  ///< Games whose deal had a difficulty rating
+  double totalDifficulty;   ///< Sum of the difficulty of rated games
+  unsigned int ratedWins;   ///< Rated games that were won
+  double wonDifficulty;     ///< Sum of the difficulty of rated wins
 };
 
 /**
@@ -21,13 +21,7 @@ bool TargetPile::isValid(const Card &card) {
       return false;
     }
   }
-  if (card.getSuit() != suit_) {
-    return false;
-  }
-  if (card.getRank() != cards_.back()->getRank() + 1) {
-    return false;
-  }
-  return true;
+  return canFollowOnTarget(card.getIndex(), cards_.back()->getIndex());
 }
 
 // GUI RELATED FUNCTIONS
@@ -91,6 +85,6 @@ void TargetPile::paint(QPainter *painter,
 
   // Draw the outer rectangle
   painter->setBrush(Qt::transparent);
-  painter->setPen(Qt::black);
+  painter->setPen(isHighlighted_ ? Qt::darkRed : Qt::black);
   painter->drawRect(rect_);
 }
\ No newline at end of file
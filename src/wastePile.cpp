@@ -13,11 +13,7 @@ bool WastePile::isValid(const Card& card) { return false; }
 int WastePile::addFromDeck(Deck& deck, const unsigned int nofCards) {
   size_t i = 0;
   while (i < nofCards && !deck.isEmpty()) {
-    Card* topCard = deck.getTopCard();
-    if (!topCard->isFaceUp()) {
-      topCard->flip();
-    }
-
+    deck.flipTopCard(true);
     deck.transferCards(*this);
     i++;
   }
@@ -27,10 +23,7 @@ int WastePile::addFromDeck(Deck& deck, const unsigned int nofCards) {
 void WastePile::undoAddFromDeck(Deck& deck, const unsigned int nofCards) {
   size_t i = 0;
   while (i < nofCards && !this->isEmpty()) {
-    Card* topCard = getTopCard();
-    if (topCard->isFaceUp()) {
-      topCard->flip();
-    }
+    flipTopCard(false);
     transferCards(deck);
     i++;
   }
@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <random>
+#include <utility>
+
+#include "engine/board.hpp"
+#include "engine/gameState.hpp"
+
+TEST_CASE("CardState: One byte packing", "[board]") {
+  REQUIRE(sizeof(CardState) == 1);
+
+  SECTION("Suit, rank and color survive packing") {
+    for (Suit suit : allSuits) {
+      for (Rank rank : allRanks) {
+        CardState card(suit, rank);
+        REQUIRE(card.getSuit() == suit);
+        REQUIRE(card.getRank() == rank);
+        REQUIRE(card.getColor() == suitColor(suit));
+        REQUIRE(CardState::fromIndex(card.getIndex()).sameCard(card));
+      }
+    }
+  }
+
+  SECTION("Flipping only changes the face-up bit") {
+    CardState card(HEARTS, QUEEN);
+    REQUIRE(!card.isFaceUp());
+    card.flip();
+    REQUIRE(card.isFaceUp());
+    REQUIRE(card.getSuit() == HEARTS);
+    REQUIRE(card.getRank() == QUEEN);
+  }
+}
+
+TEST_CASE("Board: Copy with memcpy", "[board]") {
+  GameState state(99);
+  Board copy;
+  std::memcpy(&copy, &state.getBoard(), sizeof(Board));
+
+  state.attemptDeckMove();
+
+  REQUIRE(copy.piles[Board::deckIndex].getSize() == 24);
+  REQUIRE(copy.piles[Board::wasteIndex].isEmpty());
+  REQUIRE(state.getWPile().getSize() == 1);
+  for (int i = Board::firstKlondikeIndex; i < Board::firstTargetIndex; i++) {
+    REQUIRE(Board::isKlondike(i));
+    REQUIRE(copy.piles[i].getKind() == KLONDIKE_PILE);
+    REQUIRE(copy.piles[i].getSize() == state.getPile(i).getSize());
+  }
+  REQUIRE(Board::isTarget(Board::pileAm - 1));
+}
+
+// Hash of a board rebuilt card by card, to check the incremental updates.
+static uint64_t rehash(const Board& board) {
+  Board copy;
+  for (int i = 0; i < Board::pileAm; i++) {
+    for (size_t j = 0; j < board.piles[i].getSize(); j++) {
+      copy.piles[i].addCard(board.piles[i].getCard(j));
+    }
+  }
+  return copy.hash();
+}
+
+TEST_CASE("Board: Incremental Zobrist hash", "[board]") {
+  REQUIRE(Board().hash() == 0);
+
+  std::mt19937 rng(7);
+  for (bool hardMode : {false, true}) {
+    GameState state(11, hardMode);
+    const uint64_t start = state.hash();
+    REQUIRE(start == rehash(state.getBoard()));
+
+    uint64_t last = start;
+    for (int i = 0; i < 300 && !state.hasWon(); i++) {
+      MoveList moves;
+      state.legalMoves(moves);
+      if (moves.empty()) break;
+      state.applyMove(moves.moves[rng() % moves.size]);
+      REQUIRE(state.hash() == rehash(state.getBoard()));
+      last = state.hash();
+    }
+    REQUIRE(last != start);
+
+    // Undo walks the hashes back
+    while (state.undo()) {
+      REQUIRE(state.hash() == rehash(state.getBoard()));
+    }
+    REQUIRE(state.hash() == start);
+  }
+
+  SECTION("Face and order change the hash") {
+    Board board;
+    PileState& deck = board.piles[Board::deckIndex];
+    deck.addCard(CardState(CLUBS, ACE));
+    deck.addCard(CardState(HEARTS, TWO));
+    const uint64_t hash = board.hash();
+
+    deck.flipTopCard(true);
+    REQUIRE(board.hash() != hash);
+    deck.flipTopCard(false);
+    REQUIRE(board.hash() == hash);
+
+    Board swapped;
+    swapped.piles[Board::deckIndex].addCard(CardState(HEARTS, TWO));
+    swapped.piles[Board::deckIndex].addCard(CardState(CLUBS, ACE));
+    REQUIRE(swapped.hash() != hash);
+
+    deck.transferCards(board.piles[Board::wasteIndex]);
+    REQUIRE(board.hash() != hash);
+    REQUIRE(board.hash() == rehash(board));
+  }
+}
+
+TEST_CASE("Board: Canonical hash", "[board]") {
+  const Board board = GameState(11).getBoard();
+  const int first = Board::firstKlondikeIndex;
+
+  // Swapping two columns gives another position that plays the same
+  Board swapped = board;
+  std::swap(swapped.piles[first + 2], swapped.piles[first + 5]);
+  REQUIRE(swapped.hash() != board.hash());
+  REQUIRE(swapped.canonicalHash() == board.canonicalHash());
+
+  // So does putting the aces up in another order
+  Board aces;
+  Board otherAces;
+  for (int i = 0; i < TARGET_PILE_AM; i++) {
+    aces.piles[Board::firstTargetIndex + i].addCard(
+        CardState(allSuits[i], ACE, true));
+    otherAces.piles[Board::firstTargetIndex + i].addCard(
+        CardState(allSuits[TARGET_PILE_AM - 1 - i], ACE, true));
+  }
+  REQUIRE(aces.hash() != otherAces.hash());
+  REQUIRE(aces.canonicalHash() == otherAces.canonicalHash());
+
+  // Cards trading places between columns is another position
+  Board traded;
+  Board other;
+  traded.piles[first].addCard(CardState(SPADES, KING, true));
+  traded.piles[first].addCard(CardState(HEARTS, QUEEN, true));
+  traded.piles[first + 1].addCard(CardState(CLUBS, KING, true));
+  traded.piles[first + 1].addCard(CardState(DIAMONDS, QUEEN, true));
+  other.piles[first].addCard(CardState(SPADES, KING, true));
+  other.piles[first].addCard(CardState(DIAMONDS, QUEEN, true));
+  other.piles[first + 1].addCard(CardState(CLUBS, KING, true));
+  other.piles[first + 1].addCard(CardState(HEARTS, QUEEN, true));
+  REQUIRE(traded.canonicalHash() != other.canonicalHash());
+}
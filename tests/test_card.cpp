@@ -1,7 +1,15 @@
+#include <QDir>
+#include <QFile>
 #include <QGuiApplication>
+#include <QPainter>
+#include <QTemporaryDir>
+#include <bitset>
+#include <cstring>
 #include <catch2/catch_test_macros.hpp>
 
 #include "card.hpp"
+#include "cardAssets.hpp"
+#include "cardImages.hpp"
 #include "qtTestApp.hpp"
 
 QGuiApplication* QtTestApp::app = nullptr;  // Definition
@@ -42,3 +50,213 @@ TEST_CASE_METHOD(QtTestApp, "Card String Representation", "[card]") {
     REQUIRE(card.cardToQString() == "jack_of_diamonds");
   }
 }
+
+TEST_CASE_METHOD(QtTestApp, "Card images are shared", "[card]") {
+  SECTION("Every face is decoded and has the same size") {
+    for (int i = 0; i < CardImages::faceCount; i++) {
+      REQUIRE_FALSE(CardImages::face(i).isNull());
+      REQUIRE(CardImages::face(i).size() == CardImages::size());
+    }
+  }
+
+  SECTION("Paths follow the card names") {
+    Card card(Suit::CLUBS, Rank::TEN);
+    REQUIRE(CardImages::path(card.getIndex()) ==
+            QString(":/cards/%1.png").arg(card.cardToQString()));
+    REQUIRE(CardImages::path(CardImages::backIndex) ==
+            ":/cards/face_down.png");
+  }
+
+  SECTION("Repeated lookups return the same image") {
+    qint64 key = CardImages::front(Suit::HEARTS, Rank::QUEEN).cacheKey();
+    Card first(Suit::HEARTS, Rank::QUEEN);
+    Card second(Suit::HEARTS, Rank::QUEEN);
+    REQUIRE(CardImages::front(Suit::HEARTS, Rank::QUEEN).cacheKey() == key);
+    REQUIRE(CardImages::back().cacheKey() == CardImages::back().cacheKey());
+  }
+}
+
+TEST_CASE_METHOD(QtTestApp, "Card renditions", "[card]") {
+  CardImages::setRenditionScale(0.25, 2.0);
+  const QSize size = CardImages::renditionSize();
+  REQUIRE(size == (QSizeF(CardImages::size()) * 0.5).toSize());
+
+  SECTION("The atlas holds every face at the device size") {
+    const QImage& atlas = CardImages::atlas();
+    REQUIRE(CardImages::renditionDpr() == 2.0);
+    for (int i = 0; i < CardImages::faceCount; i++) {
+      QRect source = CardImages::sourceRect(i);
+      REQUIRE(source.size() == size);
+      REQUIRE(atlas.rect().contains(source));
+      for (int j = 0; j < i; j++) {
+        REQUIRE_FALSE(source.intersects(CardImages::sourceRect(j)));
+      }
+    }
+  }
+
+  SECTION("A card at the rendition size covers its device pixels 1:1") {
+    Card card(Suit::SPADES, Rank::KING);
+    QImage target(size * 2, QImage::Format_ARGB32_Premultiplied);
+    target.setDevicePixelRatio(2.0);
+    target.fill(Qt::transparent);
+    QPainter painter(&target);
+    painter.translate(10.3, 5.2);
+    painter.scale(0.25, 0.25);
+    card.paint(&painter, nullptr, nullptr);
+    painter.end();
+
+    // Bounds of the painted pixels, the corners may be transparent
+    QRect painted;
+    for (int y = 0; y < target.height(); y++) {
+      for (int x = 0; x < target.width(); x++) {
+        if (qAlpha(target.pixel(x, y)) != 0) {
+          painted |= QRect(x, y, 1, 1);
+        }
+      }
+    }
+    const QRect expected(QPoint(21, 10), size);
+    REQUIRE(expected.contains(painted));
+    REQUIRE(painted.width() >= size.width() - 2);
+    REQUIRE(painted.height() >= size.height() - 2);
+  }
+
+  SECTION("The atlas is only rebuilt when the scale changes") {
+    qint64 key = CardImages::atlas().cacheKey();
+    CardImages::setRenditionScale(0.25, 2.0);
+    REQUIRE(CardImages::atlas().cacheKey() == key);
+    CardImages::setRenditionScale(0.2, 1.0);
+    REQUIRE(CardImages::atlas().cacheKey() != key);
+    REQUIRE(CardImages::sourceRect(0).size() == CardImages::renditionSize());
+  }
+}
+
+TEST_CASE_METHOD(QtTestApp, "Card pack", "[card]") {
+  QTemporaryDir dir;
+  const QString fileName = dir.filePath(CardImages::packName);
+  REQUIRE(CardImages::writePack(fileName));
+
+  QFile file(fileName);
+  REQUIRE(file.open(QIODevice::ReadOnly));
+  const QByteArray pack = file.readAll();
+  const QSize size = CardImages::size();
+  const qsizetype faceBytes = qsizetype(size.width()) * size.height() * 4;
+
+  SECTION("Header and size match the faces") {
+    REQUIRE(pack.left(4) == "KCP2");
+    uint32_t fields[3];
+    memcpy(fields, pack.constData() + 4, sizeof(fields));
+    REQUIRE(fields[0] == CardImages::faceCount);
+    REQUIRE(fields[1] == uint32_t(size.width()));
+    REQUIRE(fields[2] == uint32_t(size.height()));
+    REQUIRE(pack.size() < faceBytes * CardImages::faceCount / 2);
+  }
+
+  SECTION("Faces are read back premultiplied in index order") {
+    QImage images[CardImages::faceCount];
+    REQUIRE(CardImages::readPack(fileName, images));
+    for (int i = 0; i < CardImages::faceCount; i++) {
+      REQUIRE(images[i].format() == QImage::Format_ARGB32_Premultiplied);
+      REQUIRE(images[i] == CardImages::face(i));
+    }
+  }
+
+  SECTION("A truncated pack is rejected") {
+    QFile truncated(dir.filePath("truncated.pack"));
+    REQUIRE(truncated.open(QIODevice::WriteOnly));
+    truncated.write(pack.left(pack.size() - 8));
+    truncated.close();
+    QImage images[CardImages::faceCount];
+    REQUIRE_FALSE(CardImages::readPack(truncated.fileName(), images));
+  }
+}
+
+TEST_CASE_METHOD(QtTestApp, "Card atlas cache", "[card]") {
+  QTemporaryDir dir;
+  CardImages::setCacheDir(dir.path());
+  CardImages::setRenditionScale(0.1, 1.0);
+  const QImage built = CardImages::atlas().copy();
+  REQUIRE(CardImages::saveCache());
+
+  SECTION("The saved atlas is mapped back at the same size") {
+    const QStringList saved = QDir(dir.path()).entryList({"atlas-*.raw"});
+    REQUIRE(saved.size() == 1);
+    REQUIRE(saved.first().endsWith(QString(CARD_IMAGES_HASH) + ".raw"));
+    CardImages::setRenditionScale(0.05, 1.0);
+    REQUIRE(CardImages::atlas().size() != built.size());
+    CardImages::setRenditionScale(0.1, 1.0);
+    REQUIRE(CardImages::atlas().copy() == built);
+    REQUIRE(CardImages::renditionDpr() == 1.0);
+  }
+
+  SECTION("A high-dpi atlas is used straight from the mapped file") {
+    CardImages::setRenditionScale(0.05, 2.0);
+    REQUIRE(CardImages::saveCache());
+    CardImages::setRenditionScale(0.1, 1.0);
+    CardImages::atlas();
+    CardImages::setRenditionScale(0.05, 2.0);
+    const QImage& mapped = CardImages::atlas();
+    REQUIRE(CardImages::renditionDpr() == 2.0);
+
+    // A write to the file shows in the atlas only if it was not copied
+    const QStringList saved =
+        QDir(dir.path()).entryList({"atlas-*-2000-*.raw"});
+    REQUIRE(saved.size() == 1);
+    QFile file(dir.filePath(saved.first()));
+    REQUIRE(file.open(QIODevice::ReadWrite));
+    const uint32_t marker = 0x12345678;
+    REQUIRE(file.seek(16));
+    REQUIRE(file.write(reinterpret_cast<const char*>(&marker),
+                       sizeof(marker)) == sizeof(marker));
+    file.close();
+    uint32_t pixel;
+    memcpy(&pixel, mapped.constBits(), sizeof(pixel));
+    REQUIRE(pixel == marker);
+  }
+
+  SECTION("Only the most recent atlases are kept") {
+    for (int i = 1; i <= CardImages::maxCachedAtlases + 1; i++) {
+      CardImages::setRenditionScale(0.1 + 0.01 * i, 1.0);
+      REQUIRE(CardImages::saveCache());
+    }
+    REQUIRE(QDir(dir.path()).entryList({"atlas-*.raw"}).size() ==
+            CardImages::maxCachedAtlases);
+  }
+
+  CardImages::setCacheDir(QString());
+}
+
+TEST_CASE("Move tables", "[card]") {
+  SECTION("Klondike stacking needs opposite color and one rank lower") {
+    for (int card = 0; card < 52; card++) {
+      for (int parent = 0; parent < 52; parent++) {
+        bool expected =
+            suitColor(indexSuit(card)) != suitColor(indexSuit(parent)) &&
+            indexRank(card) + 1 == indexRank(parent);
+        REQUIRE(canStackOnKlondike(card, parent) == expected);
+        REQUIRE(((moveTables.stackParents[card] & cardBit(parent)) != 0) ==
+                expected);
+        REQUIRE(((moveTables.stackChildren[parent] & cardBit(card)) != 0) ==
+                expected);
+      }
+    }
+  }
+
+  SECTION("Target piles need the same suit and one rank higher") {
+    for (int card = 0; card < 52; card++) {
+      for (int top = 0; top < 52; top++) {
+        bool expected = indexSuit(card) == indexSuit(top) &&
+                        indexRank(card) == indexRank(top) + 1;
+        REQUIRE(canFollowOnTarget(card, top) == expected);
+        REQUIRE(((moveTables.followParents[card] & cardBit(top)) != 0) ==
+                expected);
+      }
+    }
+  }
+
+  SECTION("Aces and kings masks") {
+    REQUIRE(std::bitset<64>(aceMask).count() == 4);
+    REQUIRE(std::bitset<64>(kingMask).count() == 4);
+    REQUIRE((aceMask & cardBit(cardIndex(HEARTS, ACE))) != 0);
+    REQUIRE((kingMask & cardBit(cardIndex(SPADES, KING))) != 0);
+  }
+}
@@ -0,0 +1,49 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "engine/deal.hpp"
+#include "engine/gameState.hpp"
+
+static std::vector<int> firstIndices(uint64_t dealNumber, int count) {
+  std::vector<int> indices;
+  std::vector<CardState> deck = shuffledDeck(dealNumber);
+  for (int i = 0; i < count; i++) indices.push_back(deck[i].getIndex());
+  return indices;
+}
+
+TEST_CASE("DealRandom: SplitMix64 sequence", "[deal]") {
+  DealRandom random(0);
+  REQUIRE(random.next() == 0xe220a8397b1dcdafull);
+  REQUIRE(random.next() == 0x6e789e6aa1b965f4ull);
+  REQUIRE(random.next() == 0x06c45d188009454full);
+
+  DealRandom bounded(123);
+  for (uint64_t bound = 1; bound <= 52; bound++) {
+    REQUIRE(bounded.below(bound) < bound);
+  }
+}
+
+TEST_CASE("Deal: Same deal number, same deal everywhere", "[deal]") {
+  // Fixed values, the deal must not depend on the standard library
+  REQUIRE(firstIndices(0, 8) == std::vector<int>{46, 36, 8, 40, 14, 24, 44, 9});
+  REQUIRE(firstIndices(1, 8) ==
+          std::vector<int>{19, 8, 16, 33, 20, 43, 23, 18});
+  REQUIRE(firstIndices(~0ull, 8) ==
+          std::vector<int>{10, 51, 45, 3, 13, 36, 17, 27});
+
+  SECTION("Every deal is a permutation") {
+    for (uint64_t dealNumber = 0; dealNumber < 100; dealNumber++) {
+      std::vector<int> indices = firstIndices(dealNumber, DECK_SIZE);
+      std::sort(indices.begin(), indices.end());
+      for (int i = 0; i < DECK_SIZE; i++) REQUIRE(indices[i] == i);
+    }
+  }
+
+  SECTION("Games with the same deal number start the same") {
+    GameState first(987654321);
+    GameState second(987654321);
+    REQUIRE(first.hash() == second.hash());
+    REQUIRE(GameState(987654322).hash() != first.hash());
+  }
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "engine/dealAnalysis.hpp"
+
+// Keeps the records written to it.
+class CollectingWriter : public DealRecordWriter {
+ public:
+  void write(const DealRecord& record) override { records.push_back(record); }
+  std::vector<DealRecord> records;
+};
+
+TEST_CASE("DealAnalysis: Solve one deal", "[dealAnalysis]") {
+  SolverLimits limits;
+  limits.maxNodes = 50000;
+  DealRecord record = analyzeDeal(1, 1, limits);
+  REQUIRE(record.seed == 1);
+  REQUIRE(record.outcome == WINNABLE);
+  REQUIRE(record.solutionLength > 0);
+  REQUIRE(record.nodes > 0);
+}
+
+TEST_CASE("DealAnalysis: Split one deal across threads", "[dealAnalysis]") {
+  SolverLimits limits;
+  limits.maxSeconds = 10;
+  DealRecord serial = analyzeDeal(29, 3, limits);
+  DealRecord split = analyzeDeal(29, 3, limits, nullptr, 2);
+  REQUIRE(serial.outcome == UNWINNABLE);
+  REQUIRE(split.outcome == UNWINNABLE);
+  REQUIRE(serial.workers.size() == 1);
+  REQUIRE(split.workers.size() == 2);
+
+  uint64_t nodes = 0;
+  for (const WorkerStats& stats : split.workers) nodes += stats.nodes;
+  REQUIRE(nodes == split.nodes);
+}
+
+TEST_CASE("DealAnalysis: Every seed of a range is written once",
+          "[dealAnalysis]") {
+  SolverLimits limits;
+  limits.maxNodes = 5000;
+  CollectingWriter writer;
+  analyzeDeals(10, 21, 3, limits, 3, writer);
+
+  std::set<uint64_t> seeds;
+  for (const DealRecord& record : writer.records) seeds.insert(record.seed);
+  REQUIRE(writer.records.size() == 12);
+  REQUIRE(seeds.size() == 12);
+  REQUIRE(*seeds.begin() == 10);
+  REQUIRE(*seeds.rbegin() == 21);
+}
+
+TEST_CASE("DealAnalysis: Output formats", "[dealAnalysis]") {
+  DealRecord record;
+  record.seed = 0x0123456789abcdefull;
+  record.outcome = UNWINNABLE;
+  record.solutionLength = 0;
+  record.nodes = 123456789;
+  record.seconds = 1.5;
+
+  SECTION("CSV") {
+    std::ostringstream out;
+    CsvRecordWriter writer(out);
+    writer.write(record);
+    REQUIRE(out.str() ==
+            "seed,result,solution_length,nodes,seconds\n"
+            "81985529216486895,loss,0,123456789,1.5\n");
+  }
+
+  SECTION("Binary round trip") {
+    std::stringstream stream;
+    BinaryRecordWriter writer(stream, 3);
+    writer.write(record);
+    record.seed = 7;
+    record.outcome = WINNABLE;
+    record.solutionLength = 140;
+    writer.write(record);
+    REQUIRE(stream.str().size() == 5 + 2 * BinaryRecordWriter::recordSize);
+
+    int drawCount = 0;
+    DealRecord read;
+    REQUIRE(readBinaryHeader(stream, drawCount));
+    REQUIRE(drawCount == 3);
+    REQUIRE(readBinaryRecord(stream, read));
+    REQUIRE(read.seed == 0x0123456789abcdefull);
+    REQUIRE(read.outcome == UNWINNABLE);
+    REQUIRE(read.nodes == 123456789);
+    REQUIRE(read.seconds == 1.5);
+    REQUIRE(readBinaryRecord(stream, read));
+    REQUIRE(read.seed == 7);
+    REQUIRE(read.outcome == WINNABLE);
+    REQUIRE(read.solutionLength == 140);
+    REQUIRE_FALSE(readBinaryRecord(stream, read));
+  }
+}
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+#include "engine/deal.hpp"
+#include "engine/dealAnalysis.hpp"
+#include "engine/dealGenerator.hpp"
+
+// Wait until the generator holds a number of deals, or give up.
+static bool waitForDeals(const DealGenerator& generator, size_t amount) {
+  const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+  while (generator.size() < amount) {
+    if (std::chrono::steady_clock::now() > end) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return true;
+}
+
+TEST_CASE("DealGenerator: Queued deals are winnable", "[dealGenerator]") {
+  DealGenerator generator(nullptr, 2);
+  generator.start(1);
+  REQUIRE(waitForDeals(generator, 2));
+  // The queue is kept at its size
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  REQUIRE(generator.size() == 2);
+
+  const uint64_t dealNumber = generator.next();
+  SolverLimits limits;
+  limits.maxSeconds = 10;
+  REQUIRE(analyzeDeal(dealNumber, 1, limits).outcome == WINNABLE);
+  // Taking a deal makes room for another one
+  REQUIRE(waitForDeals(generator, 2));
+}
+
+TEST_CASE("DealGenerator: Draw count change empties the queue",
+          "[dealGenerator]") {
+  DealGenerator generator(nullptr, 1);
+  generator.start(1);
+  REQUIRE(waitForDeals(generator, 1));
+  generator.stop();
+  REQUIRE(generator.size() == 1);
+
+  generator.start(3);
+  REQUIRE(generator.getDrawCount() == 3);
+  // Solved after the switch or built in, so for the new draw count
+  SolverLimits limits;
+  limits.maxSeconds = 10;
+  REQUIRE(analyzeDeal(generator.next(), 3, limits).outcome == WINNABLE);
+}
+
+TEST_CASE("DealGenerator: Empty queue hands out proven deals",
+          "[dealGenerator]") {
+  SolverLimits limits;
+  limits.maxNodes = 100000;
+  for (int drawCount : {1, 3}) {
+    size_t count;
+    const uint64_t* known = DealGenerator::knownDeals(drawCount, count);
+    REQUIRE(count > 0);
+    for (size_t i = 0; i < count; i++) {
+      REQUIRE(analyzeDeal(known[i], drawCount, limits).outcome == WINNABLE);
+    }
+
+    // Stopped before it could solve anything, so the queue is empty
+    DealGenerator generator(nullptr, 1);
+    generator.start(drawCount);
+    generator.stop();
+    for (int i = 0; i < 20; i++) {
+      const uint64_t dealNumber = generator.next();
+      if (std::find(known, known + count, dealNumber) == known + count) {
+        // The worker was quicker than the stop, the deal is still proven
+        REQUIRE(analyzeDeal(dealNumber, drawCount, limits).outcome ==
+                WINNABLE);
+      }
+    }
+  }
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "engine/deal.hpp"
+#include "engine/dealId.hpp"
+
+static std::vector<int> indices(const std::vector<CardState>& cards) {
+  std::vector<int> result;
+  for (const CardState& card : cards) result.push_back(card.getIndex());
+  return result;
+}
+
+TEST_CASE("DealId: First and last orders", "[dealId]") {
+  std::vector<CardState> sorted = unrankDeal(DealId());
+  for (int i = 0; i < DECK_SIZE; i++) REQUIRE(sorted[i].getIndex() == i);
+  REQUIRE(rankDeal(sorted) == DealId());
+
+  std::vector<CardState> reversed(sorted.rbegin(), sorted.rend());
+  DealId last = rankDeal(reversed);
+  REQUIRE(last.isValid());
+  REQUIRE(last.toString() ==
+          "2fde529a3274c649cfeb4b180adb5cb9602a9e0638ab1ffffffffffff");
+  REQUIRE(indices(unrankDeal(last)) == indices(reversed));
+
+  DealId end = last;
+  REQUIRE_FALSE(nextDealId(end));
+  REQUIRE(end == last);
+  REQUIRE_FALSE(DealId::fromString(
+      "2fde529a3274c649cfeb4b180adb5cb9602a9e0638ab2000000000000", end));
+}
+
+TEST_CASE("DealId: Round trips", "[dealId]") {
+  DealRandom random(2024);
+  for (int i = 0; i < 200; i++) {
+    DealId id = randomDealId(random);
+    REQUIRE(id.isValid());
+    REQUIRE(rankDeal(unrankDeal(id)) == id);
+
+    DealId parsed;
+    REQUIRE(DealId::fromString(id.toString(), parsed));
+    REQUIRE(parsed == id);
+  }
+
+  for (uint64_t dealNumber = 0; dealNumber < 50; dealNumber++) {
+    std::vector<CardState> deck = shuffledDeck(dealNumber);
+    REQUIRE(indices(unrankDeal(rankDeal(deck))) == indices(deck));
+  }
+
+  DealId parsed;
+  REQUIRE(DealId::fromString("ff", parsed));
+  REQUIRE(parsed.words[0] == 255);
+  REQUIRE_FALSE(DealId::fromString("", parsed));
+  REQUIRE_FALSE(DealId::fromString("12g", parsed));
+}
+
+TEST_CASE("DealId: Enumeration follows lexicographic order", "[dealId]") {
+  DealRandom random(7);
+  DealId id = randomDealId(random);
+  std::vector<int> order = indices(unrankDeal(id));
+  for (int i = 0; i < 500; i++) {
+    DealId previous = id;
+    REQUIRE(nextDealId(id));
+    REQUIRE(previous < id);
+    REQUIRE(std::next_permutation(order.begin(), order.end()));
+    REQUIRE(indices(unrankDeal(id)) == order);
+  }
+}
@@ -64,3 +64,15 @@ TEST_CASE_METHOD(QtTestApp, "WastePile: Transfer Cards Back to Deck",
     REQUIRE(wastePile.isEmpty());   // WastePile is empty
   }
 }
+
+TEST_CASE_METHOD(QtTestApp, "Deck: Deal id round trip", "[deck]") {
+  Deck deck(uint64_t(42));
+  Deck copy(deck.getDealId());
+
+  REQUIRE(copy.getSize() == 52);
+  REQUIRE(copy.getDealId() == deck.getDealId());
+  for (size_t i = 0; i < deck.getSize(); i++) {
+    REQUIRE(copy.getCardFromBack(i)->getIndex() ==
+            deck.getCardFromBack(i)->getIndex());
+  }
+}
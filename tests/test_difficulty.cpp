@@ -0,0 +1,130 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "engine/deal.hpp"
+#include "engine/difficulty.hpp"
+
+static SolverLimits testLimits() {
+  SolverLimits limits;
+  limits.maxNodes = 50000;
+  return limits;
+}
+
+TEST_CASE("Difficulty: Score", "[difficulty]") {
+  DifficultyRating easy;
+  easy.outcome = WINNABLE;
+  easy.nodes = 50;
+  easy.solutionLength = 70;
+  easy.randomWins = 8;
+  easy.playouts = 8;
+  REQUIRE(difficultyScore(easy) == 0);
+
+  DifficultyRating hard = easy;
+  hard.nodes = 100000000;
+  hard.solutionLength = 200;
+  hard.randomWins = 0;
+  REQUIRE(difficultyScore(hard) == 100);
+
+  DifficultyRating lost;
+  lost.outcome = UNWINNABLE;
+  REQUIRE(difficultyScore(lost) == 100);
+}
+
+TEST_CASE("Difficulty: Rate one deal", "[difficulty]") {
+  DifficultyRating rating = rateDeal(1, 1, testLimits(), 8);
+  REQUIRE(rating.outcome == WINNABLE);
+  REQUIRE(rating.nodes > 0);
+  REQUIRE(rating.solutionLength > 0);
+  REQUIRE(rating.playouts == 8);
+  REQUIRE(rating.score >= 0);
+  REQUIRE(rating.score <= 100);
+
+  // Playouts are seeded with the deal
+  DifficultyRating again = rateDeal(1, 1, testLimits(), 8);
+  REQUIRE(again.randomWins == rating.randomWins);
+  REQUIRE(again.score == rating.score);
+}
+
+TEST_CASE("Difficulty: Rater pool and saved ratings", "[difficulty]") {
+  std::stringstream saved;
+  {
+    DifficultyRater rater(2, testLimits(), 4, 2);
+    for (uint64_t seed = 1; seed <= 5; seed++) {
+      rater.rate(seed, 1);
+    }
+    rater.wait();
+    REQUIRE(rater.size() == 5);
+    rater.save(saved);
+  }
+
+  DifficultyRater loaded(1, testLimits(), 4, 1);
+  REQUIRE(loaded.load(saved));
+  REQUIRE(loaded.size() == 5);
+  DifficultyRating rating;
+  REQUIRE(loaded.find(rankDeal(shuffledDeck(3)), 1, rating));
+  REQUIRE(rating.playouts == 4);
+  REQUIRE_FALSE(loaded.find(rankDeal(shuffledDeck(3)), 3, rating));
+
+  // Known deals are answered without queueing
+  bool called = false;
+  REQUIRE(loaded.request(3, 1, [&called](const DifficultyRating&) {
+    called = true;
+  }));
+  REQUIRE(called);
+
+  std::stringstream bad("seed,score\n1,2\n");
+  REQUIRE_FALSE(loaded.load(bad));
+}
+
+TEST_CASE("Difficulty: Stale saved ratings", "[difficulty]") {
+  DifficultyRater rater(1, testLimits(), 4, 1);
+  rater.rate(2, 1);
+  rater.wait();
+  DifficultyRating fresh;
+  REQUIRE(rater.find(rankDeal(shuffledDeck(2)), 1, fresh));
+  const std::string id2 = rankDeal(shuffledDeck(2)).toString();
+  const std::string id3 = rankDeal(shuffledDeck(3)).toString();
+  const std::string id4 = rankDeal(shuffledDeck(4)).toString();
+  const std::string current = std::to_string(Solver::version);
+  std::stringstream saved(
+      "deal_id,draw,score,result,nodes,solution_length,random_wins,"
+      "playouts,solver\n" +
+      id2 + ",1,100,loss,2,0,0,4," + current + "\n" + id3 +
+      ",1,100,loss,2,0,0,4,0\n" + id4 + ",1,100,loss,2,0,0,4\n");
+  REQUIRE(rater.load(saved));
+
+  // A rating computed here is kept over the file's
+  DifficultyRating rating;
+  REQUIRE(rater.find(rankDeal(shuffledDeck(2)), 1, rating));
+  REQUIRE(rating.score == fresh.score);
+  REQUIRE(rating.nodes == fresh.nodes);
+
+  // Ratings of other solvers, or from before versions, are rated again
+  REQUIRE_FALSE(rater.find(rankDeal(shuffledDeck(3)), 1, rating));
+  REQUIRE_FALSE(rater.find(rankDeal(shuffledDeck(4)), 1, rating));
+  REQUIRE(rater.size() == 1);
+}
+
+TEST_CASE("Difficulty: Stopping the rater", "[difficulty]") {
+  // Deal 29 takes the solver over half a second to prove lost in draw 3
+  SolverLimits limits;
+  limits.maxSeconds = 30;
+  DifficultyRater rater(1, limits);
+  std::atomic<int> calls(0);
+  REQUIRE(rater.request(29, 3, [&calls](const DifficultyRating&) {
+    calls++;
+  }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  const auto start = std::chrono::steady_clock::now();
+  rater.stop();
+  REQUIRE(std::chrono::steady_clock::now() - start <
+          std::chrono::milliseconds(300));
+  REQUIRE(calls == 0);
+  REQUIRE(rater.size() == 0);
+  REQUIRE_FALSE(rater.request(1, 1));
+}
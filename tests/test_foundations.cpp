@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/foundations.hpp"
+
+TEST_CASE("Foundations: Empty targets", "[foundations]") {
+  Foundations foundations;
+  for (Suit suit : allSuits) {
+    REQUIRE(foundations.getHeight(suit) == 0);
+    REQUIRE(foundations.getSafeRank(suit) == TWO);
+    REQUIRE(foundations.safeCard(suit) == cardIndex(suit, ACE));
+  }
+  REQUIRE(foundations.isSafe(HEARTS, TWO));
+  REQUIRE_FALSE(foundations.isSafe(HEARTS, THREE));
+}
+
+TEST_CASE("Foundations: Safe ranks follow the heights", "[foundations]") {
+  Foundations foundations;
+  const CardState twoOfClubs(CLUBS, TWO, true);
+  const CardState twoOfSpades(SPADES, TWO, true);
+  const CardState twoOfHearts(HEARTS, TWO, true);
+
+  const CardState aceOfDiamonds(DIAMONDS, ACE, true);
+
+  // A 3 of hearts is safe once both black 2s and the ace of diamonds are up
+  foundations.setPile(0, &twoOfClubs);
+  REQUIRE_FALSE(foundations.isSafe(HEARTS, THREE));
+  foundations.setPile(1, &twoOfSpades);
+  foundations.setPile(2, &twoOfHearts);
+  REQUIRE(foundations.getHeight(HEARTS) == 2);
+  REQUIRE_FALSE(foundations.isSafe(HEARTS, THREE));
+  REQUIRE(foundations.safeCard(HEARTS) == -1);
+  REQUIRE(foundations.safeCard(DIAMONDS) == cardIndex(DIAMONDS, ACE));
+  foundations.setPile(3, &aceOfDiamonds);
+  REQUIRE(foundations.isSafe(HEARTS, THREE));
+  REQUIRE(foundations.safeCard(HEARTS) == cardIndex(HEARTS, THREE));
+
+  // Black 3s still wait for the 2 of diamonds
+  REQUIRE(foundations.getSafeRank(CLUBS) == TWO);
+
+  // Emptying a pile drops its suit back to zero
+  foundations.setPile(0, nullptr);
+  REQUIRE(foundations.getHeight(CLUBS) == 0);
+  REQUIRE_FALSE(foundations.isSafe(HEARTS, THREE));
+}
+
+TEST_CASE("Foundations: Complete suit", "[foundations]") {
+  Foundations foundations;
+  const CardState kings[] = {
+      CardState(CLUBS, KING, true), CardState(DIAMONDS, KING, true),
+      CardState(SPADES, KING, true), CardState(HEARTS, KING, true)};
+  for (int i = 0; i < TARGET_PILE_AM; i++) {
+    foundations.setPile(i, &kings[i]);
+  }
+  for (Suit suit : allSuits) {
+    REQUIRE(foundations.getSafeRank(suit) == KING);
+    REQUIRE(foundations.safeCard(suit) == -1);
+  }
+}
@@ -1,5 +1,8 @@
+#include <QElapsedTimer>
 #include <QGuiApplication>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
 
 #include "card.hpp"
 #include "game.hpp"
@@ -89,3 +92,186 @@ TEST_CASE_METHOD(QtTestApp, "Game Win Condition with Existing TargetPiles",
   // Verify the game recognizes the win condition
   REQUIRE(game.hasWon() == true);
 }
+
+TEST_CASE_METHOD(QtTestApp, "Game Legal Moves", "[game]") {
+  Game game;
+  game.startGame();
+
+  SECTION("Board mirrors the piles") {
+    const Board& board = game.getBoard();
+    for (int i = 0; i < Board::pileAm; i++) {
+      REQUIRE(board.piles[i].getSize() == game.getPile(i)->getSize());
+      REQUIRE(game.pileIndex(game.getPile(i)) == i);
+    }
+  }
+
+  SECTION("Deck draw is listed and stays in sync after undo") {
+    MoveList moves = game.legalMoves();
+    bool hasDraw = false;
+    for (const auto& move : moves) hasDraw |= move.type_ == DECK_TO_WASTE;
+    REQUIRE(hasDraw);
+
+    game.logMove(Move(DECK_TO_WASTE, game.getDeck(), game.getWPile(),
+                      game.getWPile()->addFromDeck(*game.getDeck(), 1), 0));
+    REQUIRE(game.getBoard().piles[Board::wasteIndex].getSize() == 1);
+    game.undo();
+    REQUIRE(game.getBoard().piles[Board::wasteIndex].isEmpty());
+    REQUIRE(game.getBoard().piles[Board::deckIndex].getSize() == 24);
+  }
+}
+
+TEST_CASE_METHOD(QtTestApp, "Game Zobrist Hash", "[game]") {
+  Game game;
+  game.startGame();
+  const uint64_t start = game.hash();
+  REQUIRE(start == game.getBoard().hash());
+
+  game.logMove(Move(DECK_TO_WASTE, game.getDeck(), game.getWPile(),
+                    game.getWPile()->addFromDeck(*game.getDeck(), 3), 0));
+  REQUIRE(game.hash() != start);
+  REQUIRE(game.hash() == game.getBoard().hash());
+
+  game.undo();
+  REQUIRE(game.hash() == start);
+}
+
+TEST_CASE_METHOD(QtTestApp, "Game Deal Number", "[game]") {
+  Game first(42);
+  Game second(42);
+  first.startGame();
+  second.startGame();
+
+  REQUIRE(first.getDealNumber() == 42);
+  REQUIRE(first.hash() == second.hash());
+  REQUIRE(first.getBoard().hash() == GameState(42).hash());
+}
+
+TEST_CASE_METHOD(QtTestApp, "Game Hint Plan", "[game]") {
+  Game game(1);
+  game.startGame();
+
+  // The hint of the deal is searched for in the background
+  QElapsedTimer timer;
+  timer.start();
+  while (game.getHintPlan().empty() && timer.elapsed() < 5000) {
+    QCoreApplication::processEvents();
+  }
+  std::vector<BoardMove> plan = game.getHintPlan();
+  REQUIRE_FALSE(plan.empty());
+  REQUIRE(plan.size() <= HintEngine::defaultPlanLength);
+
+  bool isLegal = false;
+  for (const auto& move : game.legalMoves()) isLegal |= move == plan[0];
+  REQUIRE(isLegal);
+  REQUIRE(game.getPile(plan[0].fromPile_) != nullptr);
+  REQUIRE(game.getPile(plan[0].toPile_) != nullptr);
+}
+
+TEST_CASE_METHOD(QtTestApp, "Game Dead End Mode Switch", "[game]") {
+  // Deal 29 is proven lost in draw 1 within milliseconds, while draw 3 needs
+  // far longer than the dead end deadline
+  Game game(29);
+  game.setDeadEndDeadline(100);
+  game.startGame();
+
+  // Let the draw 1 verdict of the background hint be posted, then switch
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  game.toggleHardMode();
+  QElapsedTimer timer;
+  timer.start();
+  while (timer.elapsed() < 300) {
+    QCoreApplication::processEvents();
+  }
+  REQUIRE_FALSE(game.isDeadEnd());
+
+  // Switching back checks the position again for draw 1
+  game.toggleHardMode();
+  timer.restart();
+  while (!game.isDeadEnd() && timer.elapsed() < 5000) {
+    QCoreApplication::processEvents();
+  }
+  REQUIRE(game.isDeadEnd());
+}
+
+TEST_CASE_METHOD(QtTestApp, "Game Auto Finish", "[game]") {
+  Game game(1);
+  auto klondikePiles = game.getKPiles();
+  auto targetPiles = game.getTPiles();
+
+  // Empty the deck, then lay out kings down to twos face up, one suit per
+  // column, with the aces on the targets except the ace of clubs
+  TestTargetPile tempPile;
+  game.getDeck()->transferCards(tempPile, game.getDeck()->getSize());
+  for (Suit suit : allSuits) {
+    for (int rank = KING; rank >= ACE; rank--) {
+      Card* card = new Card(suit, static_cast<Rank>(rank));
+      card->flip();
+      tempPile.addCard(card);
+      if (rank != ACE) {
+        tempPile.transferCards(*klondikePiles[suit]);
+      } else if (suit != CLUBS) {
+        tempPile.transferCards(*targetPiles[suit]);
+      } else {
+        tempPile.transferCards(*klondikePiles[4]);
+      }
+    }
+  }
+  REQUIRE(game.canAutoFinish());
+
+  // Playing the last ace finishes the game in one batch
+  Card* ace = klondikePiles[4]->getTopCard();
+  REQUIRE(game.attemptMove(ace, klondikePiles[4], targetPiles[CLUBS]) == 1);
+  game.logMove(Move(KLONDIKE_TO_TARGET, klondikePiles[4], targetPiles[CLUBS],
+                    1, game.pointChange(KLONDIKE_TO_TARGET)));
+  REQUIRE(game.hasWon());
+
+  // A single undo takes back the whole batch
+  game.undo();
+  REQUIRE_FALSE(game.hasWon());
+  for (Suit suit : allSuits) {
+    REQUIRE(targetPiles[suit]->getSize() == 1);
+    REQUIRE(klondikePiles[suit]->getSize() == 12);
+  }
+  game.undo();
+  REQUIRE(targetPiles[CLUBS]->isEmpty());
+  REQUIRE(klondikePiles[4]->getSize() == 1);
+}
+
+TEST_CASE_METHOD(QtTestApp, "Game Auto Play Safe Cards", "[game]") {
+  Game game(1);
+  game.setAutoPlay(true);
+  auto klondikePiles = game.getKPiles();
+  auto targetPiles = game.getTPiles();
+
+  // Ace of clubs on the first column, 2 of clubs over a face down king on
+  // the second and a 3 of clubs, which needs both red 2s up, on the third
+  TestTargetPile tempPile;
+  auto place = [&tempPile](Suit suit, Rank rank, bool faceUp, Pile* pile) {
+    Card* card = new Card(suit, rank);
+    if (faceUp) card->flip();
+    tempPile.addCard(card);
+    tempPile.transferCards(*pile);
+    return card;
+  };
+  Card* ace = place(CLUBS, ACE, true, klondikePiles[0]);
+  Card* king = place(SPADES, KING, false, klondikePiles[1]);
+  place(CLUBS, TWO, true, klondikePiles[1]);
+  place(CLUBS, THREE, true, klondikePiles[2]);
+
+  REQUIRE(game.attemptMove(ace, klondikePiles[0], targetPiles[0]) == 1);
+  game.logMove(Move(KLONDIKE_TO_TARGET, klondikePiles[0], targetPiles[0], 1,
+                    game.pointChange(KLONDIKE_TO_TARGET)));
+
+  // The 2 follows on its own and uncovers the king, the 3 is not safe yet
+  REQUIRE(targetPiles[0]->getSize() == 2);
+  REQUIRE(klondikePiles[1]->getTopCard() == king);
+  REQUIRE(king->isFaceUp());
+  REQUIRE(klondikePiles[2]->getSize() == 1);
+
+  // Undo takes back the move with everything that followed it
+  game.undo();
+  REQUIRE(targetPiles[0]->isEmpty());
+  REQUIRE(klondikePiles[0]->getTopCard() == ace);
+  REQUIRE(klondikePiles[1]->getSize() == 2);
+  REQUIRE_FALSE(king->isFaceUp());
+}
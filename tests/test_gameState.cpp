@@ -0,0 +1,125 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/gameState.hpp"
+
+// Ordered deck where the given cards are placed at given positions from the
+// top of the deck. Position 0 is dealt to Klondike pile 0, position 2 is the
+// top card of Klondike pile 1.
+static std::vector<CardState> stackedDeck(
+    const std::vector<std::pair<int, CardState>>& placed) {
+  std::vector<CardState> deck;
+  for (Suit suit : allSuits) {
+    for (Rank rank : allRanks) {
+      deck.emplace_back(suit, rank);
+    }
+  }
+  for (auto& [fromTop, card] : placed) {
+    size_t target = deck.size() - 1 - fromTop;
+    for (size_t i = 0; i < deck.size(); i++) {
+      if (deck[i].sameCard(card)) {
+        std::swap(deck[i], deck[target]);
+        break;
+      }
+    }
+  }
+  return deck;
+}
+
+TEST_CASE("GameState: Initialization", "[gameState]") {
+  GameState state(42);
+
+  REQUIRE(state.getDeck().getSize() == 24);
+  REQUIRE(state.getWPile().isEmpty());
+  for (int i = 0; i < KLONDIKE_PILE_AM; i++) {
+    REQUIRE(state.getKPile(i).getSize() == static_cast<size_t>(i + 1));
+    REQUIRE(state.getKPile(i).getTopCard()->isFaceUp());
+    if (i > 0) REQUIRE(!state.getKPile(i).getCardFromBack(1)->isFaceUp());
+  }
+  for (int i = 0; i < TARGET_PILE_AM; i++) {
+    REQUIRE(state.getTPile(i).isEmpty());
+  }
+  REQUIRE(state.getPoints() == 0);
+  REQUIRE(state.hasWon() == false);
+}
+
+TEST_CASE("GameState: Same seed deals the same cards", "[gameState]") {
+  GameState a(1234);
+  GameState b(1234);
+  for (int p = 0; p < GameState::pileAm; p++) {
+    REQUIRE(a.getPile(p).getSize() == b.getPile(p).getSize());
+    for (size_t i = 0; i < a.getPile(p).getSize(); i++) {
+      REQUIRE(a.getPile(p).getCardFromBack(i)->sameCard(
+          *b.getPile(p).getCardFromBack(i)));
+    }
+  }
+}
+
+TEST_CASE("GameState: Deck moves", "[gameState]") {
+  GameState state(7);
+
+  SECTION("Draw one card") {
+    REQUIRE(state.attemptDeckMove() == 1);
+    REQUIRE(state.getDeck().getSize() == 23);
+    REQUIRE(state.getWPile().getTopCard()->isFaceUp());
+  }
+
+  SECTION("Draw three cards in hard mode") {
+    state.setHardMode(true);
+    REQUIRE(state.attemptDeckMove() == 3);
+    REQUIRE(state.getDeck().getSize() == 21);
+    REQUIRE(state.getWPile().getSize() == 3);
+  }
+
+  SECTION("Recycle and undo") {
+    const CardState first = *state.getDeck().getTopCard();
+    while (!state.getDeck().isEmpty()) state.attemptDeckMove();
+    REQUIRE(state.attemptDeckMove() == -1);
+    REQUIRE(state.getDeck().getSize() == 24);
+    REQUIRE(state.getDeck().getTopCard()->sameCard(first));
+    REQUIRE(!state.getDeck().getTopCard()->isFaceUp());
+    REQUIRE(state.getPoints() == 0);  // Points cannot go negative
+
+    REQUIRE(state.undo());
+    REQUIRE(state.getDeck().isEmpty());
+    REQUIRE(state.getWPile().getSize() == 24);
+
+    REQUIRE(state.undo());
+    REQUIRE(state.getDeck().getSize() == 1);
+    REQUIRE(!state.getDeck().getTopCard()->isFaceUp());
+  }
+}
+
+TEST_CASE("GameState: Klondike moves and scoring", "[gameState]") {
+  GameState state(stackedDeck({{0, CardState(SPADES, EIGHT)},
+                               {2, CardState(HEARTS, SEVEN)},
+                               {5, CardState(CLUBS, SEVEN)}}));
+
+  const int k0 = GameState::firstKlondikeIndex;
+  const int k1 = k0 + 1;
+  const int k2 = k0 + 2;
+
+  SECTION("Illegal moves are rejected") {
+    REQUIRE(state.attemptMove(k2, 1, k0) == 0);  // Same color
+    REQUIRE(state.attemptMove(k0, 1, k1) == 0);  // Higher rank
+    REQUIRE(state.attemptMove(k1, 2, k0) == 0);  // Face-down card
+    REQUIRE(state.getMoves() == 0);
+  }
+
+  SECTION("Legal move flips the card below") {
+    REQUIRE(state.attemptMove(k1, 1, k0) == 1);
+    REQUIRE(state.getKPile(0).getSize() == 2);
+    REQUIRE(state.getKPile(1).getSize() == 1);
+    REQUIRE(state.getKPile(1).getTopCard()->isFaceUp());
+    REQUIRE(state.getPoints() == MovePoints::kToKPoints +
+                                     MovePoints::turnOverPoints);
+    REQUIRE(state.getMoves() == 1);
+
+    REQUIRE(state.undo());
+    REQUIRE(state.getKPile(0).getSize() == 1);
+    REQUIRE(state.getKPile(1).getSize() == 2);
+    REQUIRE(!state.getKPile(1).getCardFromBack(1)->isFaceUp());
+    REQUIRE(state.getKPile(1).getTopCard()->sameCard(CardState(HEARTS, SEVEN)));
+    REQUIRE(state.getPoints() == 0);
+    REQUIRE(state.getMoves() == 0);
+  }
+}
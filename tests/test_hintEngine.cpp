@@ -0,0 +1,186 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+#include "engine/gameState.hpp"
+#include "engine/hintEngine.hpp"
+
+TEST_CASE("HintEngine: Winning line", "[hintEngine]") {
+  // Every card except the kings is on the targets
+  Board board;
+  for (Suit suit : allSuits) {
+    for (Rank rank : allRanks) {
+      if (rank != KING) {
+        board.piles[Board::firstTargetIndex + suit].addCard(
+            CardState(suit, rank, true));
+      } else {
+        board.piles[Board::firstKlondikeIndex + suit].addCard(
+            CardState(suit, rank, true));
+      }
+    }
+  }
+
+  HintEngine engine;
+  bool called = false;
+  HintResult result =
+      engine
+          .request(board, 1, 1000,
+                   [&called](const HintResult&) { called = true; })
+          .get();
+  REQUIRE_FALSE(result.cancelled);
+  REQUIRE(result.outcome == WINNABLE);
+  REQUIRE(result.hash == board.hash());
+  REQUIRE(result.moves.size() == 4);
+  REQUIRE(result.moves[0].toPile_ >= Board::firstTargetIndex);
+  REQUIRE(called);
+}
+
+TEST_CASE("HintEngine: Deadline", "[hintEngine]") {
+  GameState state(7);
+  HintEngine engine;
+
+  auto start = std::chrono::steady_clock::now();
+  HintResult result = engine.request(state.getBoard(), 1, 20).get();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  REQUIRE_FALSE(result.cancelled);
+  REQUIRE_FALSE(result.moves.empty());
+  REQUIRE(elapsed < std::chrono::seconds(1));
+  // The first move must be legal in the position
+  REQUIRE(state.applyMove(result.moves[0]) != 0);
+}
+
+TEST_CASE("HintEngine: Cancel", "[hintEngine]") {
+  HintEngine engine;
+  GameState first(3, true);
+  GameState second(4, true);
+
+  std::shared_future<HintResult> cancelled =
+      engine.request(first.getBoard(), 3, 10000);
+  std::shared_future<HintResult> replaced =
+      engine.request(second.getBoard(), 3, 10000);
+  engine.cancel();
+
+  REQUIRE(cancelled.wait_for(std::chrono::seconds(2)) ==
+          std::future_status::ready);
+  REQUIRE(replaced.wait_for(std::chrono::seconds(2)) ==
+          std::future_status::ready);
+  REQUIRE(cancelled.get().cancelled);
+  REQUIRE(replaced.get().cancelled);
+  REQUIRE(replaced.get().hash == second.hash());
+
+  // The engine keeps serving requests after a cancel
+  HintResult result = engine.request(first.getBoard(), 3, 20).get();
+  REQUIRE_FALSE(result.cancelled);
+}
+
+TEST_CASE("HintEngine: No callbacks after cancel", "[hintEngine]") {
+  HintEngine engine;
+  GameState state(5);
+
+  // cancel() waits for a callback that already started
+  std::atomic<bool> started(false);
+  std::atomic<bool> finished(false);
+  std::shared_future<HintResult> result = engine.request(
+      state.getBoard(), 1, 20, [&started, &finished](const HintResult&) {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+      });
+  while (!started && result.wait_for(std::chrono::milliseconds(1)) !=
+                         std::future_status::ready) {
+  }
+  engine.cancel();
+  REQUIRE(finished == started.load());
+
+  // Requests finishing around the cancel never call back after it
+  std::atomic<int> late(0);
+  for (int i = 0; i < 200; i++) {
+    std::atomic<bool> cancelled(false);
+    result = engine.request(state.getBoard(), 1, 1,
+                            [&cancelled, &late](const HintResult&) {
+                              if (cancelled) late++;
+                            });
+    std::this_thread::sleep_for(std::chrono::microseconds(i * 10));
+    engine.cancel();
+    cancelled = true;
+    result.wait();
+  }
+  REQUIRE(late == 0);
+}
+
+TEST_CASE("HintEngine: Background requests", "[hintEngine]") {
+  HintEngine engine;
+  GameState first(3, true);
+  GameState second(4, true);
+
+  // A background request waits for the interactive one
+  std::shared_future<HintResult> interactive =
+      engine.request(first.getBoard(), 3, 50);
+  std::shared_future<HintResult> background = engine.request(
+      second.getBoard(), 3, 50, nullptr, HintEngine::BACKGROUND);
+  REQUIRE_FALSE(interactive.get().cancelled);
+  REQUIRE_FALSE(background.get().cancelled);
+  REQUIRE(background.get().hash == second.hash());
+
+  // An interactive request stops a background one
+  background = engine.request(first.getBoard(), 3, 10000, nullptr,
+                              HintEngine::BACKGROUND);
+  interactive = engine.request(second.getBoard(), 3, 50);
+  REQUIRE(background.get().cancelled);
+  REQUIRE_FALSE(interactive.get().cancelled);
+}
+
+TEST_CASE("HintEngine: Plan length", "[hintEngine]") {
+  GameState state(1);
+  HintEngine engine;
+  REQUIRE(engine.getPlanLength() == HintEngine::defaultPlanLength);
+
+  engine.setPlanLength(3);
+  HintResult result = engine.request(state.getBoard(), 1, 1000).get();
+  REQUIRE(result.moves.size() <= 3);
+  REQUIRE_FALSE(result.moves.empty());
+
+  // The plan can be followed move by move
+  for (const BoardMove& move : result.moves) {
+    REQUIRE(move.fromPile_ >= 0);
+    REQUIRE(move.toPile_ >= 0);
+    REQUIRE((state.applyMove(move) != 0 || move.type_ == RECYCLE_DECK));
+  }
+}
+
+TEST_CASE("HintEngine: Dead end checks", "[hintEngine]") {
+  // The position from "Solver: Safe moves wait for the same color". It is
+  // only won by first putting a black 3 back on the 4 of hearts, so a dead
+  // end check, a one-move background request, must not report it lost.
+  Board board;
+  for (Suit suit : {CLUBS, SPADES, HEARTS}) {
+    for (Rank rank : {ACE, TWO, THREE}) {
+      board.piles[Board::firstTargetIndex + suit].addCard(
+          CardState(suit, rank, true));
+    }
+  }
+  PileState& column = board.piles[Board::firstKlondikeIndex];
+  for (int rank = KING; rank >= THREE; rank--) {
+    for (Suit suit : allSuits) {
+      if ((suit == DIAMONDS || rank > THREE) &&
+          !(suit == HEARTS && rank == FOUR)) {
+        column.addCard(CardState(suit, static_cast<Rank>(rank)));
+      }
+    }
+  }
+  column.addCard(CardState(DIAMONDS, ACE));
+  column.addCard(CardState(DIAMONDS, TWO, true));
+  board.piles[Board::firstKlondikeIndex + 1].addCard(
+      CardState(HEARTS, FOUR, true));
+
+  HintEngine engine;
+  engine.setPlanLength(1);
+  HintResult result =
+      engine.request(board, 1, 1000, nullptr, HintEngine::BACKGROUND).get();
+  REQUIRE_FALSE(result.cancelled);
+  REQUIRE(result.outcome == WINNABLE);
+  REQUIRE(result.moves.size() == 1);
+  REQUIRE(Board::isTarget(result.moves[0].fromPile_));
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+#include "engine/gameState.hpp"
+#include "engine/moveGenerator.hpp"
+
+static bool contains(const MoveList& moves, const BoardMove& move) {
+  return std::find(moves.begin(), moves.end(), move) != moves.end();
+}
+
+// Every legal (from, nofCards, to) found by trying all of them on GameState,
+// skipping the duplicates MoveGenerator leaves out.
+static std::vector<BoardMove> bruteForceMoves(const GameState& state) {
+  std::vector<BoardMove> moves;
+  for (int from = Board::wasteIndex; from < Board::pileAm; from++) {
+    const PileState& fromPile = state.getPile(from);
+    for (int nof = 1; nof <= static_cast<int>(fromPile.getSize()); nof++) {
+      for (int to = Board::firstKlondikeIndex; to < Board::pileAm; to++) {
+        GameState copy = state;
+        if (copy.attemptMove(from, nof, to) == 0) continue;
+        const bool toEmpty = state.getPile(to).isEmpty();
+        bool firstEmpty = true;
+        int first = Board::isKlondike(to) ? Board::firstKlondikeIndex
+                                          : Board::firstTargetIndex;
+        for (int p = first; p < to; p++) {
+          if (state.getPile(p).isEmpty()) firstEmpty = false;
+        }
+        if (toEmpty && !firstEmpty) continue;
+        if (toEmpty && Board::isKlondike(from) && Board::isKlondike(to) &&
+            nof == static_cast<int>(fromPile.getSize())) {
+          continue;  // King shifted between empty piles
+        }
+        moves.push_back({Board::moveType(from, to), static_cast<int8_t>(from),
+                         static_cast<int8_t>(to), static_cast<int8_t>(nof)});
+      }
+    }
+  }
+  return moves;
+}
+
+TEST_CASE("MoveGenerator: Opening position", "[moveGenerator]") {
+  GameState state(5);
+  MoveList moves;
+  state.legalMoves(moves);
+
+  REQUIRE(!moves.empty());
+  REQUIRE(contains(moves, {DECK_TO_WASTE, Board::deckIndex, Board::wasteIndex,
+                           1}));
+
+  state.setHardMode(true);
+  MoveList hardMoves;
+  state.legalMoves(hardMoves);
+  REQUIRE(contains(hardMoves, {DECK_TO_WASTE, Board::deckIndex,
+                               Board::wasteIndex, 3}));
+}
+
+TEST_CASE("MoveGenerator: Matches brute force during random play",
+          "[moveGenerator]") {
+  std::mt19937 rng(2024);
+  for (unsigned long seed = 1; seed <= 20; seed++) {
+    GameState state(seed, seed % 2 == 0);
+    for (int step = 0; step < 200 && !state.hasWon(); step++) {
+      MoveList moves;
+      state.legalMoves(moves);
+
+      // Incremental indices agree with a generator built from scratch
+      MoveGenerator fresh;
+      fresh.reset(state.getBoard());
+      MoveList freshMoves;
+      fresh.generate(state.getBoard(), state.isHardMode() ? 3 : 1,
+                     freshMoves);
+      REQUIRE(moves.size == freshMoves.size);
+      for (const auto& move : freshMoves) REQUIRE(contains(moves, move));
+
+      // Every pile move found by brute force is listed, and nothing else
+      std::vector<BoardMove> expected = bruteForceMoves(state);
+      int pileMoves = 0;
+      for (const auto& move : moves) {
+        if (move.type_ != DECK_TO_WASTE && move.type_ != RECYCLE_DECK) {
+          pileMoves++;
+        }
+      }
+      REQUIRE(pileMoves == static_cast<int>(expected.size()));
+      for (const auto& move : expected) REQUIRE(contains(moves, move));
+
+      if (moves.empty()) break;
+      const BoardMove& move = moves.moves[rng() % moves.size];
+      REQUIRE(state.applyMove(move) != 0);
+      if (rng() % 5 == 0) state.undo();
+    }
+  }
+}
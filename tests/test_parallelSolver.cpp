@@ -0,0 +1,69 @@
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+
+#include "engine/gameState.hpp"
+#include "engine/parallelSolver.hpp"
+#include "engine/transpositionTable.hpp"
+
+TEST_CASE("ConcurrentTranspositionTable: Each key is new once",
+          "[parallelSolver]") {
+  ConcurrentTranspositionTable table(1 << 16);
+  std::atomic<int> inserted(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&table, &inserted]() {
+      for (uint64_t key = 0; key < 10000; key++) {
+        if (table.insert(key * 0x9e3779b97f4a7c15ull)) inserted++;
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  REQUIRE(inserted == 10000);
+  REQUIRE(table.size() == 10000);
+  REQUIRE_FALSE(table.isFull());
+
+  SECTION("Inserts fail once the table is full") {
+    ConcurrentTranspositionTable small(16);
+    int accepted = 0;
+    for (uint64_t key = 1; key <= 16; key++) {
+      accepted += small.insert(key);
+    }
+    REQUIRE(accepted == 12);
+    REQUIRE(small.isFull());
+  }
+}
+
+TEST_CASE("ParallelSolver: Agrees with Solver", "[parallelSolver]") {
+  SolverLimits limits;
+  limits.maxNodes = 100000;
+  for (bool hardMode : {false, true}) {
+    for (unsigned long seed = 1; seed <= 6; seed++) {
+      GameState state(seed, hardMode);
+      ParallelSolver solver(state, 4);
+      REQUIRE(solver.getThreadCount() == 4);
+
+      SolveResult result = solver.solve(limits);
+      REQUIRE(result.workers.size() == 4);
+      SolveResult single = Solver(state).solve(limits);
+      if (result.outcome != UNDECIDED && single.outcome != UNDECIDED) {
+        REQUIRE(result.outcome == single.outcome);
+      }
+
+      if (result.outcome == WINNABLE) {
+        GameState replay = state;
+        for (const BoardMove& move : result.solution) {
+          replay.applyMove(move);
+        }
+        REQUIRE(replay.hasWon());
+      }
+    }
+  }
+}
+
+TEST_CASE("ParallelSolver: Full table is undecided", "[parallelSolver]") {
+  ParallelSolver solver(GameState(4), 2, 64);
+  SolveResult result = solver.solve();
+  REQUIRE(result.outcome == UNDECIDED);
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "engine/gameState.hpp"
+#include "engine/solver.hpp"
+#include "engine/transpositionTable.hpp"
+
+// Replay a solution on a copy of the game and check that it wins.
+static bool replayWins(GameState state, const std::vector<BoardMove>& moves) {
+  for (const BoardMove& move : moves) {
+    if (state.applyMove(move) == 0 && move.type_ != RECYCLE_DECK) {
+      return false;
+    }
+  }
+  return state.hasWon();
+}
+
+TEST_CASE("TranspositionTable: Insert and grow", "[solver]") {
+  TranspositionTable table(16);
+  REQUIRE(table.insert(0));
+  REQUIRE_FALSE(table.insert(0));
+  for (uint64_t key = 1; key <= 1000; key++) {
+    REQUIRE(table.insert(key * 0x10000));
+  }
+  REQUIRE(table.size() == 1001);
+  REQUIRE(table.contains(500 * 0x10000));
+  REQUIRE_FALSE(table.insert(500 * 0x10000));
+  REQUIRE_FALSE(table.contains(12345));
+
+  table.clear();
+  REQUIRE(table.size() == 0);
+  REQUIRE_FALSE(table.contains(500 * 0x10000));
+}
+
+TEST_CASE("Solver: Won position", "[solver]") {
+  Board board;
+  for (Suit suit : allSuits) {
+    for (Rank rank : allRanks) {
+      board.piles[Board::firstTargetIndex + suit].addCard(
+          CardState(suit, rank, true));
+    }
+  }
+  SolveResult result = Solver(board, 1).solve();
+  REQUIRE(result.outcome == WINNABLE);
+  REQUIRE(result.solution.empty());
+}
+
+TEST_CASE("Solver: Solutions win the game", "[solver]") {
+  SolverLimits limits;
+  limits.maxNodes = 200000;
+  for (bool hardMode : {false, true}) {
+    int won = 0;
+    for (unsigned long seed = 1; seed <= 10; seed++) {
+      GameState state(seed, hardMode);
+      SolveResult result = Solver(state).solve(limits);
+      REQUIRE(result.nodes > 0);
+      if (result.outcome == WINNABLE) {
+        won++;
+        REQUIRE(replayWins(state, result.solution));
+      } else {
+        REQUIRE(result.solution.empty());
+      }
+    }
+    REQUIRE(won > 0);
+  }
+}
+
+TEST_CASE("Solver: Unwinnable and undecided deals", "[solver]") {
+  // Only the aces are missing from the deck, so nothing can ever be played
+  Board board;
+  for (Suit suit : allSuits) {
+    for (Rank rank : allRanks) {
+      if (rank != ACE) {
+        board.piles[Board::deckIndex].addCard(CardState(suit, rank));
+      }
+    }
+  }
+  SolveResult result = Solver(board, 3).solve();
+  REQUIRE(result.outcome == UNWINNABLE);
+
+  SolverLimits limits;
+  limits.maxNodes = 1024;
+  GameState state(4);
+  result = Solver(state).solve(limits);
+  REQUIRE(result.outcome == UNDECIDED);
+  REQUIRE(result.nodes == 1024);
+}
+
+TEST_CASE("Solver: Safe moves wait for the same color", "[solver]") {
+  // Clubs, spades and hearts are up to 3 and diamonds are empty. Playing the
+  // 4 of hearts looks safe against the black 3s, but then the 2 of diamonds
+  // has no red 4 to move onto and the ace under it stays buried.
+  Board board;
+  for (Suit suit : {CLUBS, SPADES, HEARTS}) {
+    for (Rank rank : {ACE, TWO, THREE}) {
+      board.piles[Board::firstTargetIndex + suit].addCard(
+          CardState(suit, rank, true));
+    }
+  }
+  // The rest of the cards are face down under them, lowest ranks on top
+  PileState& column = board.piles[Board::firstKlondikeIndex];
+  for (int rank = KING; rank >= THREE; rank--) {
+    for (Suit suit : allSuits) {
+      const bool placed = (suit != DIAMONDS && rank <= THREE) ||
+                          (suit == HEARTS && rank == FOUR);
+      if (!placed) {
+        column.addCard(CardState(suit, static_cast<Rank>(rank)));
+      }
+    }
+  }
+  column.addCard(CardState(DIAMONDS, ACE));
+  column.addCard(CardState(DIAMONDS, TWO, true));
+  board.piles[Board::firstKlondikeIndex + 1].addCard(
+      CardState(HEARTS, FOUR, true));
+
+  SolveResult result = Solver(board, 1).solve();
+  REQUIRE(result.outcome == WINNABLE);
+  REQUIRE_FALSE(result.solution.empty());
+  REQUIRE(result.solution.front().fromPile_ != Board::firstKlondikeIndex + 1);
+}
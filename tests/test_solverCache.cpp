@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "engine/deal.hpp"
+#include "engine/dealAnalysis.hpp"
+#include "engine/solverCache.hpp"
+
+// Path of a fresh cache file, removed when the test ends.
+class TempCacheFile {
+ public:
+  explicit TempCacheFile(const std::string& name)
+      : path((std::filesystem::temp_directory_path() / name).string()) {
+    std::remove(path.c_str());
+  }
+  ~TempCacheFile() { std::remove(path.c_str()); }
+  const std::string path;
+};
+
+static SolveResult winningResult() {
+  SolveResult result;
+  result.outcome = WINNABLE;
+  result.nodes = 1234;
+  result.solution = {{DECK_TO_WASTE, 0, 1, 1}, {WASTE_TO_TARGET, 1, 9, 1}};
+  return result;
+}
+
+TEST_CASE("SolverCache: Round trip", "[solverCache]") {
+  TempCacheFile file("solver_cache_round_trip.cache");
+  SolverCache cache;
+  REQUIRE(cache.open(file.path, 64, 4096));
+  const DealId id = rankDeal(shuffledDeck(5));
+
+  CachedSolve cached;
+  REQUIRE_FALSE(cache.find(id, 1, cached));
+  REQUIRE(cache.insert(id, 1, winningResult()));
+  REQUIRE_FALSE(cache.insert(id, 1, winningResult()));
+  REQUIRE(cache.size() == 1);
+
+  REQUIRE(cache.find(id, 1, cached));
+  REQUIRE(cached.outcome == WINNABLE);
+  REQUIRE(cached.nodes == 1234);
+  REQUIRE(cached.solution == winningResult().solution);
+  // The draw count is part of the key
+  REQUIRE_FALSE(cache.find(id, 3, cached));
+
+  // Undecided results depend on the limits and are not stored
+  SolveResult undecided;
+  REQUIRE_FALSE(cache.insert(id, 3, undecided));
+
+  // Another mapping of the file, as another process would have, sees it
+  SolverCache other;
+  REQUIRE(other.open(file.path));
+  REQUIRE(other.size() == 1);
+  REQUIRE(other.find(id, 1, cached));
+  SolveResult lost;
+  lost.outcome = UNWINNABLE;
+  REQUIRE(other.insert(id, 3, lost));
+  REQUIRE(cache.find(id, 3, cached));
+  REQUIRE(cached.outcome == UNWINNABLE);
+  REQUIRE(cached.solution.empty());
+}
+
+TEST_CASE("SolverCache: Other solver versions", "[solverCache]") {
+  TempCacheFile file("solver_cache_version.cache");
+  const DealId id = rankDeal(shuffledDeck(6));
+  SolverCache old;
+  REQUIRE(old.open(file.path, 64, 4096));
+  REQUIRE(old.insert(id, 1, winningResult()));
+
+  // Rewrite the solver version in the header, after magic, sizes and counts
+  std::FILE* stream = std::fopen(file.path.c_str(), "r+b");
+  REQUIRE(stream != nullptr);
+  const uint32_t version = Solver::version - 1;
+  std::fseek(stream, 32, SEEK_SET);
+  REQUIRE(std::fwrite(&version, sizeof(version), 1, stream) == 1);
+  std::fclose(stream);
+
+  // The results are dropped and a new file is started
+  SolverCache cache;
+  REQUIRE(cache.open(file.path, 64, 4096));
+  CachedSolve cached;
+  REQUIRE(cache.size() == 0);
+  REQUIRE_FALSE(cache.find(id, 1, cached));
+  REQUIRE(cache.insert(id, 1, winningResult()));
+
+  // The old mapping keeps working on the unlinked file
+  REQUIRE(old.find(id, 1, cached));
+  REQUIRE(old.size() == 1);
+  SolverCache again;
+  REQUIRE(again.open(file.path));
+  REQUIRE(again.size() == 1);
+}
+
+TEST_CASE("SolverCache: Full cache", "[solverCache]") {
+  TempCacheFile file("solver_cache_full.cache");
+  SolverCache cache;
+  REQUIRE(cache.open(file.path, 8, 1 << 16));
+  int stored = 0;
+  for (uint64_t seed = 0; seed < 16; seed++) {
+    stored += cache.insert(rankDeal(shuffledDeck(seed)), 1, winningResult());
+  }
+  // The index is kept at most 3/4 full
+  REQUIRE(stored == 6);
+  REQUIRE(cache.size() == 6);
+  CachedSolve cached;
+  REQUIRE(cache.find(rankDeal(shuffledDeck(0)), 1, cached));
+  REQUIRE_FALSE(cache.find(rankDeal(shuffledDeck(15)), 1, cached));
+}
+
+TEST_CASE("SolverCache: Reads during appends", "[solverCache]") {
+  TempCacheFile file("solver_cache_threads.cache");
+  SolverCache cache;
+  REQUIRE(cache.open(file.path, 1024, 1 << 20));
+  const int dealAm = 300;
+  std::vector<DealId> ids;
+  for (int i = 0; i < dealAm; i++) {
+    ids.push_back(rankDeal(shuffledDeck(i)));
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; t++) {
+    threads.emplace_back([&cache, &ids, t]() {
+      for (size_t i = t; i < ids.size(); i += 2) {
+        cache.insert(ids[i], 1, winningResult());
+      }
+    });
+  }
+  int badReads = 0;
+  threads.emplace_back([&cache, &ids, &badReads]() {
+    CachedSolve cached;
+    for (int pass = 0; pass < 20; pass++) {
+      for (const DealId& id : ids) {
+        if (cache.find(id, 1, cached) &&
+            cached.solution != winningResult().solution) {
+          badReads++;
+        }
+      }
+    }
+  });
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(badReads == 0);
+  REQUIRE(cache.size() == dealAm);
+}
+
+TEST_CASE("SolverCache: Deal analysis reuses results", "[solverCache]") {
+  TempCacheFile file("solver_cache_analysis.cache");
+  SolverCache cache;
+  REQUIRE(cache.open(file.path, 64, 1 << 16));
+  SolverLimits limits;
+  limits.maxNodes = 50000;
+  DealRecord solved = analyzeDeal(1, 1, limits, &cache);
+  REQUIRE(cache.size() == 1);
+
+  CachedSolve cached;
+  REQUIRE(cache.find(rankDeal(shuffledDeck(1)), 1, cached));
+  REQUIRE(cached.solution.size() == solved.solutionLength);
+
+  DealRecord reused = analyzeDeal(1, 1, limits, &cache);
+  REQUIRE(reused.outcome == solved.outcome);
+  REQUIRE(reused.solutionLength == solved.solutionLength);
+  REQUIRE(reused.nodes == solved.nodes);
+  REQUIRE(cache.size() == 1);
+}